@@ -0,0 +1,300 @@
+#include "Renderer/Renderer.h"
+#include "GameManager.h"
+#include "InputRecording.h"
+#include "JobSystem.h"
+#include "Random.h"
+#include "Utilities.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+const int width = 800;
+const int height = 600;
+
+// Simulation ticks per second of game time unless set with --tick-rate
+const double default_tick_rate = 120.0;
+
+// Games longer than this many seconds of game time are stopped, so a player that never dies can't stall the run
+const double default_max_game_time = 600.0;
+
+// How long the random player holds a direction before picking another, in seconds
+const double random_input_hold_time = 0.25;
+
+enum InputPolicy
+{
+	INPUT_POLICY_IDLE = 0,
+	INPUT_POLICY_RANDOM = 1,
+	INPUT_POLICY_SCRIPT = 2
+};
+
+struct BatchParameters
+{
+	uint64_t games;
+	uint32_t threads;
+	uint32_t seed;
+	double tick_rate;
+	double max_game_time;
+	InputPolicy policy;
+	CollisionMode collision_mode;
+	std::string script_file;
+
+	// Read from script_file once, each game plays its own copy from the start
+	std::unique_ptr<InputPlayback> script;
+};
+
+struct GameResult
+{
+	double score;
+	double survival_time;
+	bool finished;
+};
+
+// Picks a new set of held arrow keys, sometimes with a dash, for the random player
+Input random_input(RandomStream &random)
+{
+	Input input = {};
+	input.up = random.range(0, 3) == 0;
+	input.down = !input.up && random.range(0, 2) == 0;
+	input.left = random.range(0, 3) == 0;
+	input.right = !input.left && random.range(0, 2) == 0;
+	input.w = random.range(0, 4) == 0;
+
+	return input;
+}
+
+// Plays one complete game on the calling thread against the null backends
+GameResult run_game(Renderer &renderer, const BatchParameters &parameters, uint64_t game_index)
+{
+	// One stream per game, so results don't depend on which thread ran which game
+	RandomStream random(parameters.seed, game_index);
+
+	const double tick_time = 1.0 / parameters.tick_rate;
+	const uint64_t max_ticks = static_cast<uint64_t>(parameters.max_game_time * parameters.tick_rate);
+	const uint64_t ticks_per_input = std::max<uint64_t>(1, static_cast<uint64_t>(random_input_hold_time * parameters.tick_rate));
+
+	std::unique_ptr<InputPlayback> script;
+	if (parameters.policy == INPUT_POLICY_SCRIPT)
+	{
+		script = std::make_unique<InputPlayback>(*parameters.script);
+	}
+
+	GameManager game_manager(&renderer, width, height, random.next());
+	game_manager.set_collision_mode(parameters.collision_mode);
+
+	Input input = {};
+	uint64_t tick = 0;
+
+	while (tick < max_ticks && !game_manager.game_is_over())
+	{
+		if (parameters.policy == INPUT_POLICY_RANDOM && tick % ticks_per_input == 0)
+		{
+			input = random_input(random);
+		}
+		else if (parameters.policy == INPUT_POLICY_SCRIPT && !script->next(input))
+		{
+			// Stand still once the script runs out
+			input = {};
+		}
+
+		game_manager.set_input(input);
+		game_manager.update(tick_time, width, height);
+		game_manager.resolve_collisions();
+		tick++;
+	}
+
+	GameResult result = {};
+	result.score = game_manager.get_score();
+	result.survival_time = tick * tick_time;
+	result.finished = game_manager.game_is_over();
+
+	return result;
+}
+
+// Prints the spread of one statistic over every game
+void print_distribution(const char *name, std::vector<double> values)
+{
+	std::sort(values.begin(), values.end());
+
+	double sum = 0.0;
+	for (double value : values)
+	{
+		sum += value;
+	}
+	double mean = sum / values.size();
+
+	double variance = 0.0;
+	for (double value : values)
+	{
+		variance += (value - mean) * (value - mean);
+	}
+	double deviation = std::sqrt(variance / values.size());
+
+	auto percentile = [&](double fraction)
+	{
+		return values[static_cast<size_t>(fraction * (values.size() - 1))];
+	};
+
+	std::cout << std::setw(16) << name << std::setw(12) << mean << std::setw(12) << deviation << std::setw(12) << values.front() << std::setw(12) << percentile(0.1) << std::setw(12) << percentile(0.5) << std::setw(12) << percentile(0.9) << std::setw(12) << values.back() << std::endl;
+}
+
+void print_usage()
+{
+	std::cout << "Usage: batch_simulation [--games N] [--threads N] [--seed N] [--tick-rate N] [--max-time seconds] [--input idle|random|script] [--script file] [--collision discrete|scheduled]" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+	BatchParameters parameters = {};
+	parameters.games = 10000;
+	parameters.threads = 0;
+	parameters.seed = time_seed();
+	parameters.tick_rate = default_tick_rate;
+	parameters.max_game_time = default_max_game_time;
+	parameters.policy = INPUT_POLICY_RANDOM;
+	parameters.collision_mode = COLLISION_MODE_DISCRETE;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+
+		if (i + 1 >= argc)
+		{
+			print_usage();
+			return 1;
+		}
+
+		std::string value = argv[++i];
+
+		if (argument == "--games")
+		{
+			parameters.games = std::stoull(value);
+		}
+		else if (argument == "--threads")
+		{
+			parameters.threads = static_cast<uint32_t>(std::stoul(value));
+		}
+		else if (argument == "--seed")
+		{
+			parameters.seed = static_cast<uint32_t>(std::stoul(value));
+		}
+		else if (argument == "--tick-rate")
+		{
+			parameters.tick_rate = std::stod(value);
+		}
+		else if (argument == "--max-time")
+		{
+			parameters.max_game_time = std::stod(value);
+		}
+		else if (argument == "--input" && value == "idle")
+		{
+			parameters.policy = INPUT_POLICY_IDLE;
+		}
+		else if (argument == "--input" && value == "random")
+		{
+			parameters.policy = INPUT_POLICY_RANDOM;
+		}
+		else if (argument == "--input" && value == "script")
+		{
+			parameters.policy = INPUT_POLICY_SCRIPT;
+		}
+		else if (argument == "--collision" && value == "discrete")
+		{
+			parameters.collision_mode = COLLISION_MODE_DISCRETE;
+		}
+		else if (argument == "--collision" && value == "scheduled")
+		{
+			parameters.collision_mode = COLLISION_MODE_SCHEDULED;
+		}
+		else if (argument == "--script")
+		{
+			parameters.script_file = value;
+		}
+		else
+		{
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (parameters.games == 0 || parameters.tick_rate <= 0.0 || parameters.max_game_time <= 0.0 || (parameters.policy == INPUT_POLICY_SCRIPT && parameters.script_file.empty()))
+	{
+		print_usage();
+		return 1;
+	}
+
+	if (parameters.policy == INPUT_POLICY_SCRIPT)
+	{
+		parameters.script = std::make_unique<InputPlayback>(parameters.script_file);
+	}
+
+	// Nothing is drawn or heard, so the null backends are safe to share between every game
+	SoundManager::select_backend(SOUND_BACKEND_NULL);
+	SoundManager::get_instance();
+
+	Renderer renderer = {};
+	RendererParameters renderer_parameters = {};
+	renderer_parameters.backend = RENDERER_BACKEND_NULL;
+
+	create_renderer(renderer, renderer_parameters);
+
+	JobSystem job_system(parameters.threads);
+
+	std::cout << "Simulating " << parameters.games << " games on " << job_system.get_thread_count() << " threads (seed " << parameters.seed << ")" << std::endl;
+
+	std::vector<GameResult> results(parameters.games);
+
+	auto start_time = std::chrono::high_resolution_clock::now();
+
+	// Games are independent, so each one is its own unit of work
+	job_system.parallel_for(0, parameters.games, 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			results[i] = run_game(renderer, parameters, i);
+		}
+	});
+
+	auto end_time = std::chrono::high_resolution_clock::now();
+	double seconds = std::chrono::duration<double, std::chrono::seconds::period>(end_time - start_time).count();
+
+	cleanup_renderer(renderer);
+
+	std::vector<double> scores;
+	std::vector<double> survival_times;
+	uint64_t unfinished = 0;
+	double simulated_time = 0.0;
+
+	for (const auto &result : results)
+	{
+		scores.push_back(result.score);
+		survival_times.push_back(result.survival_time);
+		simulated_time += result.survival_time;
+
+		if (!result.finished)
+		{
+			unfinished++;
+		}
+	}
+
+	std::cout << "Finished in " << seconds << " s" << std::endl;
+	std::cout << "Games per second: " << parameters.games / seconds << std::endl;
+	std::cout << "Ticks per second: " << simulated_time * parameters.tick_rate / seconds << std::endl;
+	if (unfinished > 0)
+	{
+		std::cout << unfinished << " games were stopped after " << parameters.max_game_time << " s" << std::endl;
+	}
+	std::cout << std::endl;
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::setw(16) << "" << std::setw(12) << "mean" << std::setw(12) << "std dev" << std::setw(12) << "min" << std::setw(12) << "p10" << std::setw(12) << "median" << std::setw(12) << "p90" << std::setw(12) << "max" << std::endl;
+	print_distribution("score", scores);
+	print_distribution("survival (s)", survival_times);
+
+	return 0;
+}
@@ -0,0 +1,1224 @@
+#include "SpatialHash.h"
+#include "FloorGrid.h"
+#include "JobSystem.h"
+#include "CollisionScheduler.h"
+#include "Random.h"
+#include "EntityRegistry.h"
+#include "Systems.h"
+#include "Text.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Size of an enemy collider
+const float enemy_collider_size = 0.108f;
+
+// Half the width of the area enemies move around in
+const float arena_half_width = 1.3f;
+
+// Matches broadphaseCellWidth in GameManager.h
+const float broadphase_cell_width = 0.25f;
+
+// Every heap allocation the benchmarks make, so they can report allocations per tick
+std::atomic<uint64_t> allocation_count{ 0 };
+
+void *operator new(size_t size)
+{
+	allocation_count++;
+
+	void *memory = std::malloc(size > 0 ? size : 1);
+	if (!memory)
+	{
+		throw std::bad_alloc();
+	}
+
+	return memory;
+}
+
+void operator delete(void *memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+struct Benchmark
+{
+	const char *name;
+	void (*run)();
+};
+
+// Scatters enemy sized colliders over the arena
+void scatter_colliders(std::vector<Rectangle> &colliders, uint32_t count, std::mt19937 &generator)
+{
+	std::uniform_real_distribution<float> distribution(-arena_half_width, arena_half_width - enemy_collider_size);
+
+	colliders.resize(count);
+	for (auto &collider : colliders)
+	{
+		collider.set_placement(glm::vec2(distribution(generator), distribution(generator)), glm::vec2(enemy_collider_size, enemy_collider_size));
+	}
+}
+
+// Slides every collider along x, wrapping around the arena, so each tick sees a different layout
+void move_colliders(std::vector<Rectangle> &colliders, float step)
+{
+	for (auto &collider : colliders)
+	{
+		collider.position.x += step;
+		if (collider.position.x > arena_half_width - enemy_collider_size)
+		{
+			collider.position.x -= 2.f * arena_half_width - enemy_collider_size;
+		}
+	}
+}
+
+// Compares the brute force all-pairs loop with the spatial hash broadphase
+void benchmark_broadphase()
+{
+	// Tests the spatial hash's cells over every hardware thread as well as on one
+	JobSystem job_system;
+
+	std::cout << "Broadphase: brute force vs spatial hash (cell width " << broadphase_cell_width << ", " << job_system.get_thread_count() << " threads for jobs)" << std::endl;
+	std::cout << std::setw(10) << "layout" << std::setw(10) << "colliders" << std::setw(16) << "brute tests" << std::setw(16) << "brute ns/tick" << std::setw(16) << "hash ns/tick" << std::setw(16) << "jobs ns/tick" << std::setw(14) << "hash tests" << std::setw(14) << "hash culled" << std::setw(10) << "hits" << std::endl;
+
+	// "objects" gives every collider its own owner, "game" puts the player in one object and every enemy in another like EnemyManager does,
+	// and "layers" gives every collider its own owner but puts the first on the player layer and the rest on the enemy layer
+	for (const std::string layout : { "objects", "game", "layers" })
+	{
+		for (uint32_t count : { 14u, 100u, 1000u, 4000u })
+		{
+			std::mt19937 generator(1234);
+			std::vector<Rectangle> colliders;
+			scatter_colliders(colliders, count, generator);
+
+			// Object each collider belongs to
+			std::vector<uint32_t> owners(count);
+			std::vector<CollisionLayer> layers(count, COLLISION_LAYER_DEFAULT);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				owners[i] = (layout != "game" || i == 0) ? i : 1;
+
+				if (layout == "layers")
+				{
+					layers[i] = i == 0 ? COLLISION_LAYER_PLAYER : COLLISION_LAYER_ENEMY;
+				}
+			}
+
+			// Only the "layers" layout turns any pairs of layers off
+			CollisionLayerMatrix layer_matrix(layout != "layers");
+			layer_matrix.set(COLLISION_LAYER_PLAYER, COLLISION_LAYER_ENEMY, true);
+
+			const uint32_t ticks = std::max(20u, 20000000u / (count * count));
+
+			// Brute force
+			uint64_t brute_tests = 0;
+			uint64_t brute_hits = 0;
+			auto start_time = std::chrono::high_resolution_clock::now();
+
+			for (uint32_t tick = 0; tick < ticks; tick++)
+			{
+				move_colliders(colliders, 0.013f);
+
+				for (uint32_t i = 0; i < count; i++)
+				{
+					for (uint32_t j = i + 1; j < count; j++)
+					{
+						if (owners[i] == owners[j] || !layer_matrix.collides(layers[i], layers[j]))
+						{
+							continue;
+						}
+
+						brute_tests++;
+						if (check_collision_rect_rect(&colliders[i], &colliders[j]))
+						{
+							brute_hits++;
+						}
+					}
+				}
+			}
+
+			auto end_time = std::chrono::high_resolution_clock::now();
+			double brute_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / ticks;
+
+			// Spatial hash, starting from the same layout
+			generator.seed(1234);
+			scatter_colliders(colliders, count, generator);
+
+			SpatialHash broadphase(broadphase_cell_width);
+			broadphase.set_layer_matrix(layer_matrix);
+			std::vector<std::pair<uint32_t, uint32_t>> pairs;
+			uint64_t hash_hits = 0;
+			uint64_t hash_tests = 0;
+			uint64_t hash_culled = 0;
+			start_time = std::chrono::high_resolution_clock::now();
+
+			for (uint32_t tick = 0; tick < ticks; tick++)
+			{
+				move_colliders(colliders, 0.013f);
+
+				broadphase.clear();
+				for (uint32_t i = 0; i < count; i++)
+				{
+					broadphase.insert(&colliders[i], owners[i], layers[i]);
+				}
+
+				// Pairs come back already tested
+				broadphase.find_pairs(pairs);
+				hash_hits += pairs.size();
+				hash_tests += broadphase.get_counters().tested;
+				hash_culled += broadphase.get_counters().culled;
+			}
+
+			end_time = std::chrono::high_resolution_clock::now();
+			double hash_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / ticks;
+
+			// Spatial hash again, with the cells split over the job system
+			generator.seed(1234);
+			scatter_colliders(colliders, count, generator);
+
+			uint64_t jobs_hits = 0;
+			start_time = std::chrono::high_resolution_clock::now();
+
+			for (uint32_t tick = 0; tick < ticks; tick++)
+			{
+				move_colliders(colliders, 0.013f);
+
+				broadphase.clear();
+				for (uint32_t i = 0; i < count; i++)
+				{
+					broadphase.insert(&colliders[i], owners[i], layers[i]);
+				}
+
+				broadphase.find_pairs(pairs, &job_system);
+				jobs_hits += pairs.size();
+			}
+
+			end_time = std::chrono::high_resolution_clock::now();
+			double jobs_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / ticks;
+
+			const bool hits_match = brute_hits == hash_hits && hash_hits == jobs_hits;
+
+			std::cout << std::setw(10) << layout << std::setw(10) << count << std::setw(16) << brute_tests / ticks << std::setw(16) << uint64_t(brute_time) << std::setw(16) << uint64_t(hash_time) << std::setw(16) << uint64_t(jobs_time) << std::setw(14) << hash_tests / ticks << std::setw(14) << hash_culled / ticks << std::setw(10) << (hits_match ? "match" : "MISMATCH") << std::endl;
+		}
+	}
+
+	std::cout << std::endl;
+}
+
+// Compares testing rectangles one pair at a time with the batched SIMD kernel
+void benchmark_aabb_kernel()
+{
+	std::cout << "AABB kernel: one pair at a time vs batched" << std::endl;
+	std::cout << std::setw(10) << "test" << std::setw(10) << "rects" << std::setw(16) << "scalar ns/rect" << std::setw(16) << "batch ns/rect" << std::setw(10) << "hits" << std::endl;
+
+	for (uint32_t count : { 16u, 196u, 1024u, 4096u })
+	{
+		std::mt19937 generator(1234);
+		std::vector<Rectangle> colliders;
+		scatter_colliders(colliders, count + 1, generator);
+
+		// The last collider is tested against all the others
+		RectangleBatch batch;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			batch.add(&colliders[i]);
+		}
+
+		const uint32_t repeats = 40000000u / count;
+		Rectangle *probe = &colliders[count];
+		const glm::vec2 probe_start = probe->position;
+
+		uint64_t scalar_hits = 0;
+		auto start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t repeat = 0; repeat < repeats; repeat++)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				if (check_collision_rect_rect(probe, &colliders[i]))
+				{
+					scalar_hits++;
+				}
+			}
+
+			// Nudge the probe so the loop can't be hoisted
+			probe->position.x = repeat % 2 == 0 ? probe->position.x + 0.001f : probe->position.x - 0.001f;
+		}
+
+		auto end_time = std::chrono::high_resolution_clock::now();
+		double scalar_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / (double(repeats) * count);
+
+		// Start the probe from the same place for the batched run
+		probe->position = probe_start;
+
+		std::vector<uint32_t> hits;
+		uint64_t batch_hits = 0;
+		start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t repeat = 0; repeat < repeats; repeat++)
+		{
+			hits.clear();
+			batch_hits += check_collision_rect_batch(probe, batch, 0, batch.size(), hits);
+
+			probe->position.x = repeat % 2 == 0 ? probe->position.x + 0.001f : probe->position.x - 0.001f;
+		}
+
+		end_time = std::chrono::high_resolution_clock::now();
+		double batch_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / (double(repeats) * count);
+
+		std::cout << std::setw(10) << "1xN" << std::setw(10) << count << std::setw(16) << scalar_time << std::setw(16) << batch_time << std::setw(10) << (scalar_hits == batch_hits ? "match" : "MISMATCH") << std::endl;
+	}
+
+	// Every enemy sized collider against every floor sized tile
+	for (uint32_t count : { 64u, 512u })
+	{
+		std::mt19937 generator(4321);
+		std::vector<Rectangle> colliders_1;
+		std::vector<Rectangle> colliders_2;
+		scatter_colliders(colliders_1, count, generator);
+		scatter_colliders(colliders_2, count, generator);
+
+		RectangleBatch batch_1;
+		RectangleBatch batch_2;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			batch_1.add(&colliders_1[i]);
+			batch_2.add(&colliders_2[i]);
+		}
+
+		const uint32_t repeats = std::max(1u, 40000000u / (count * count));
+
+		uint64_t scalar_hits = 0;
+		auto start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t repeat = 0; repeat < repeats; repeat++)
+		{
+			for (uint32_t i = 0; i < count; i++)
+			{
+				for (uint32_t j = 0; j < count; j++)
+				{
+					if (check_collision_rect_rect(&colliders_1[i], &colliders_2[j]))
+					{
+						scalar_hits++;
+					}
+				}
+			}
+		}
+
+		auto end_time = std::chrono::high_resolution_clock::now();
+		double scalar_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / (double(repeats) * count * count);
+
+		std::vector<std::pair<uint32_t, uint32_t>> hits;
+		uint64_t batch_hits = 0;
+		start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t repeat = 0; repeat < repeats; repeat++)
+		{
+			check_collision_batch_batch(batch_1, batch_2, hits);
+			batch_hits += hits.size();
+		}
+
+		end_time = std::chrono::high_resolution_clock::now();
+		double batch_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / (double(repeats) * count * count);
+
+		std::cout << std::setw(10) << "NxM" << std::setw(10) << count << std::setw(16) << scalar_time << std::setw(16) << batch_time << std::setw(10) << (scalar_hits == batch_hits ? "match" : "MISMATCH") << std::endl;
+	}
+
+	std::cout << std::endl;
+}
+
+// Compares testing every floor tile against each collider with computing the covered tiles directly
+void benchmark_floor_marking()
+{
+	// Matches halfWidth in GameManager.h
+	const float floor_half_width = 1.0355f;
+
+	std::cout << "Floor marking: test every tile vs covered tile range" << std::endl;
+	std::cout << std::setw(10) << "grid" << std::setw(10) << "colliders" << std::setw(16) << "tiles ns/tick" << std::setw(16) << "range ns/tick" << std::setw(10) << "tiles" << std::endl;
+
+	for (uint32_t grid_size : { 14u, 32u })
+	{
+		for (uint32_t count : { 14u, 1000u })
+		{
+			std::mt19937 generator(1234);
+			std::vector<Rectangle> colliders;
+			scatter_colliders(colliders, count, generator);
+
+			const float tile_width = (2.f * floor_half_width) / grid_size;
+			const uint32_t ticks = std::max(20u, 20000000u / (count * grid_size * grid_size));
+
+			std::vector<float> tested_tiles(grid_size * grid_size, 0.f);
+			auto start_time = std::chrono::high_resolution_clock::now();
+
+			for (uint32_t tick = 0; tick < ticks; tick++)
+			{
+				move_colliders(colliders, 0.013f);
+
+				for (const auto &collider : colliders)
+				{
+					for (uint32_t k = 0; k < grid_size; k++)
+					{
+						for (uint32_t f = 0; f < grid_size; f++)
+						{
+							Rectangle floor_rect;
+							floor_rect.set_placement(glm::vec2(-floor_half_width + k * tile_width, -floor_half_width + f * tile_width), glm::vec2(tile_width, tile_width));
+							if (check_collision_rect_rect(&collider, &floor_rect))
+							{
+								tested_tiles[k * grid_size + f] = 1.f;
+							}
+						}
+					}
+				}
+			}
+
+			auto end_time = std::chrono::high_resolution_clock::now();
+			double tiles_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / ticks;
+
+			generator.seed(1234);
+			scatter_colliders(colliders, count, generator);
+
+			FloorGrid floor_grid(grid_size, floor_half_width);
+			start_time = std::chrono::high_resolution_clock::now();
+
+			for (uint32_t tick = 0; tick < ticks; tick++)
+			{
+				move_colliders(colliders, 0.013f);
+
+				for (const auto &collider : colliders)
+				{
+					floor_grid.mark(&collider);
+				}
+			}
+
+			end_time = std::chrono::high_resolution_clock::now();
+			double range_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / ticks;
+
+			std::cout << std::setw(10) << grid_size << std::setw(10) << count << std::setw(16) << uint64_t(tiles_time) << std::setw(16) << uint64_t(range_time) << std::setw(10) << (tested_tiles == floor_grid.get_active_tiles() ? "match" : "MISMATCH") << std::endl;
+		}
+	}
+
+	std::cout << std::endl;
+}
+
+// Runs an enemy style update and uniform packing pass over a large crowd with more and more threads
+void benchmark_job_scaling()
+{
+	const size_t enemy_count = 200000;
+	const uint32_t ticks = 200;
+	const float tick_time = 1.f / 120.f;
+
+	// Matches the grain EnemyManager splits work at
+	const size_t grain = 1024;
+
+	std::cout << "Job system scaling: " << enemy_count << " enemies, update and uniform packing" << std::endl;
+	std::cout << std::setw(10) << "threads" << std::setw(16) << "ms/tick" << std::setw(10) << "speedup" << std::endl;
+
+	std::vector<uint32_t> thread_counts = { 1 };
+	const uint32_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+	for (uint32_t threads = 2; threads < hardware_threads; threads *= 2)
+	{
+		thread_counts.push_back(threads);
+	}
+	if (hardware_threads > 1)
+	{
+		thread_counts.push_back(hardware_threads);
+	}
+
+	double single_thread_time = 0.0;
+
+	for (uint32_t threads : thread_counts)
+	{
+		JobSystem job_system(threads);
+
+		std::mt19937 generator(1234);
+		std::uniform_real_distribution<float> distribution(-arena_half_width, arena_half_width);
+
+		std::vector<glm::vec2> locations(enemy_count);
+		std::vector<glm::vec2> directions(enemy_count);
+		std::vector<float> speeds(enemy_count, 0.f);
+		std::vector<float> accelerations(enemy_count, 1.2f);
+		std::vector<glm::mat4> models(enemy_count);
+
+		for (size_t i = 0; i < enemy_count; i++)
+		{
+			locations[i] = glm::vec2(distribution(generator), distribution(generator));
+			directions[i] = i % 2 == 0 ? glm::vec2(1.0, 0.0) : glm::vec2(0.0, -1.0);
+		}
+
+		auto start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t tick = 0; tick < ticks; tick++)
+		{
+			job_system.parallel_for(0, enemy_count, grain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					accelerations[i] += 0.75f * tick_time;
+					speeds[i] += tick_time * accelerations[i];
+					locations[i] += (tick_time * speeds[i]) * directions[i];
+
+					// Wrap around instead of respawning
+					if (glm::dot(locations[i], directions[i]) > arena_half_width)
+					{
+						locations[i] -= 2.f * arena_half_width * directions[i];
+						speeds[i] = 0.f;
+						accelerations[i] = 1.2f;
+					}
+				}
+			});
+
+			job_system.parallel_for(0, enemy_count, grain, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					models[i] = glm::translate(glm::mat4(1), glm::vec3(locations[i], -0.44f)) * glm::scale(glm::mat4(1), glm::vec3(0.12f));
+				}
+			});
+		}
+
+		auto end_time = std::chrono::high_resolution_clock::now();
+		double tick_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count() / ticks;
+
+		if (threads == 1)
+		{
+			single_thread_time = tick_ms;
+		}
+
+		std::cout << std::setw(10) << threads << std::setw(16) << tick_ms << std::setw(10) << single_thread_time / tick_ms << std::endl;
+	}
+
+	std::cout << std::endl;
+}
+
+// Compares the old shared mt19937 with a distribution built per call against a game's RandomStream
+void benchmark_random()
+{
+	const uint32_t calls = 20000000;
+
+	std::cout << "Random numbers: " << calls << " draws from 0 to 99" << std::endl;
+	std::cout << std::setw(24) << "generator" << std::setw(12) << "ns/call" << std::setw(16) << "sum" << std::endl;
+
+	auto report = [&](const char *name, auto draw)
+	{
+		uint64_t sum = 0;
+
+		auto start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t i = 0; i < calls; i++)
+		{
+			sum += draw();
+		}
+
+		auto end_time = std::chrono::high_resolution_clock::now();
+		double ns = std::chrono::duration<double, std::nano>(end_time - start_time).count() / calls;
+
+		// The sum keeps the draws from being optimized away, and should come out near 99 / 2 per call for both
+		std::cout << std::setw(24) << name << std::setw(12) << ns << std::setw(16) << sum << std::endl;
+	};
+
+	std::mt19937 generator(1234);
+	report("mt19937 + distribution", [&]()
+	{
+		std::uniform_int_distribution<int> distribution(0, 99);
+		return distribution(generator);
+	});
+
+	RandomStream stream(1234);
+	report("RandomStream::range", [&]()
+	{
+		return stream.range(0, 99);
+	});
+
+	std::cout << std::endl;
+}
+
+// Compares testing the player against every enemy each tick through the broadphase with testing only when the
+// scheduler predicts they could touch. Enemies move like EnemyManager's and the player wanders and dashes.
+void benchmark_collision_scheduling()
+{
+	const float player_size = 0.3f;
+	const float player_speed = 1.2f;
+	const float player_dash_speed = 3.8f;
+	const float enemy_jerk = 0.75f;
+	const float enemy_start_acceleration = 1.2f;
+	const glm::vec2 enemy_directions[4] = { glm::vec2(0.0, -1.0), glm::vec2(0.0, 1.0), glm::vec2(-1.0, 0.0), glm::vec2(1.0, 0.0) };
+
+	std::cout << "Collision scheduling: discrete broadphase vs time of impact queue" << std::endl;
+	std::cout << std::setw(10) << "enemies" << std::setw(12) << "tick rate" << std::setw(18) << "discrete ns/tick" << std::setw(18) << "scheduled ns/tick" << std::setw(14) << "tests/tick" << std::setw(16) << "discrete hits" << std::setw(16) << "scheduled hits" << std::setw(10) << "missed" << std::endl;
+
+	for (uint32_t count : { 256u, 4096u, 32768u })
+	{
+		for (float tick_rate : { 120.f, 15.f })
+		{
+			const float tick_time = 1.f / tick_rate;
+			const uint32_t ticks = std::max(200u, 2000000u / count);
+
+			RandomStream random(1234);
+			ColliderRegistry registry;
+			const uint32_t player_owner = registry.add_owner();
+			const uint32_t enemy_owner = registry.add_owner();
+
+			glm::vec2 player_location(0.0);
+			glm::vec2 player_direction(0.0);
+			uint32_t dash_ticks = 0;
+			ColliderID player = registry.add(player_owner, 0, COLLISION_LAYER_PLAYER);
+			registry.get(player).set_placement(player_location - glm::vec2(player_size / 2.f), glm::vec2(player_size));
+
+			ColliderMotion player_motion = {};
+			player_motion.type = COLLIDER_MOTION_BOUNDED;
+			player_motion.max_speed = player_dash_speed;
+			registry.set_motion(player, player_motion);
+
+			std::vector<glm::vec2> locations(count);
+			std::vector<glm::vec2> directions(count);
+			std::vector<float> speeds(count);
+			std::vector<float> accelerations(count);
+			std::vector<ColliderID> enemies(count);
+
+			// Starts an enemy over on the far side of the arena, part way along its path if requested
+			auto respawn = [&](uint32_t i, float progress)
+			{
+				directions[i] = enemy_directions[random.range(0, 3)];
+				glm::vec2 cross_axis = glm::vec2(std::abs(directions[i].y), std::abs(directions[i].x));
+				locations[i] = (-1.2f + 2.5f * progress) * directions[i] + float(1.75 * (random.range(0, 100) / 100.0 - 0.5)) * cross_axis;
+				speeds[i] = 0.f;
+				accelerations[i] = enemy_start_acceleration;
+			};
+
+			auto place = [&](uint32_t i)
+			{
+				registry.get(enemies[i]).set_placement(locations[i] - glm::vec2(enemy_collider_size / 2.f), glm::vec2(enemy_collider_size));
+			};
+
+			auto set_motion = [&](uint32_t i)
+			{
+				ColliderMotion motion = {};
+				motion.type = COLLIDER_MOTION_ACCELERATING;
+				motion.direction = directions[i];
+				motion.speed = speeds[i];
+				motion.acceleration = accelerations[i];
+				motion.jerk = enemy_jerk;
+				registry.set_motion(enemies[i], motion);
+			};
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				enemies[i] = registry.add(enemy_owner, i, COLLISION_LAYER_ENEMY);
+				respawn(i, random.uniform());
+				place(i);
+				set_motion(i);
+			}
+
+			SpatialHash broadphase(broadphase_cell_width);
+			std::vector<std::pair<uint32_t, uint32_t>> discrete_pairs;
+
+			CollisionScheduler scheduler;
+			std::vector<std::pair<ColliderID, ColliderID>> scheduled_pairs;
+
+			std::vector<ColliderID> discrete_hits;
+			std::vector<ColliderID> scheduled_hits;
+			std::vector<uint32_t> redirected;
+
+			double discrete_time = 0.0;
+			double scheduled_time = 0.0;
+			uint64_t tests = 0;
+			uint64_t discrete_hit_count = 0;
+			uint64_t scheduled_hit_count = 0;
+			uint64_t missed = 0;
+
+			for (uint32_t tick = 0; tick < ticks; tick++)
+			{
+				// Move the enemies the same way EnemyManager does
+				redirected.clear();
+				for (uint32_t i = 0; i < count; i++)
+				{
+					if (glm::dot(locations[i], directions[i]) > 1.3f)
+					{
+						respawn(i, 0.f);
+						redirected.push_back(i);
+					}
+
+					accelerations[i] += enemy_jerk * tick_time;
+					speeds[i] += tick_time * accelerations[i];
+					locations[i] += (tick_time * speeds[i]) * directions[i];
+					place(i);
+				}
+
+				for (auto i : redirected)
+				{
+					set_motion(i);
+				}
+
+				// Wander, with the odd dash
+				if (tick % 30 == 0)
+				{
+					player_direction = glm::vec2(random.range(-1, 1), random.range(-1, 1));
+					if (player_direction != glm::vec2(0.0))
+					{
+						player_direction = glm::normalize(player_direction);
+					}
+					dash_ticks = random.range(0, 3) == 0 ? uint32_t(0.1f * tick_rate) + 1 : 0;
+				}
+
+				const float speed = dash_ticks > 0 ? player_dash_speed : player_speed;
+				dash_ticks = dash_ticks > 0 ? dash_ticks - 1 : 0;
+				player_location = glm::clamp(player_location + tick_time * speed * player_direction, glm::vec2(-0.74f), glm::vec2(0.74f));
+				registry.get(player).set_placement(player_location - glm::vec2(player_size / 2.f), glm::vec2(player_size));
+
+				// Every collider through the broadphase
+				auto start_time = std::chrono::high_resolution_clock::now();
+
+				broadphase.clear();
+				const auto &colliders = registry.get_colliders();
+				const auto &owners = registry.get_owners();
+				for (size_t i = 0; i < colliders.size(); i++)
+				{
+					broadphase.insert(&colliders[i], owners[i]);
+				}
+				broadphase.find_pairs(discrete_pairs);
+
+				auto end_time = std::chrono::high_resolution_clock::now();
+				discrete_time += std::chrono::duration<double, std::nano>(end_time - start_time).count();
+
+				// Only what the queue says is due
+				start_time = std::chrono::high_resolution_clock::now();
+
+				scheduler.find_pairs(registry, tick_time, scheduled_pairs);
+
+				end_time = std::chrono::high_resolution_clock::now();
+				scheduled_time += std::chrono::duration<double, std::nano>(end_time - start_time).count();
+				tests += scheduler.get_counters().tested;
+
+				// Every enemy the broadphase saw touching the player has to have been caught by the scheduler too
+				const auto &ids = registry.get_ids();
+				discrete_hits.clear();
+				for (auto pair : discrete_pairs)
+				{
+					discrete_hits.push_back(ids[pair.first] == player ? ids[pair.second] : ids[pair.first]);
+				}
+
+				scheduled_hits.clear();
+				for (auto pair : scheduled_pairs)
+				{
+					scheduled_hits.push_back(pair.first == player ? pair.second : pair.first);
+				}
+
+				std::sort(scheduled_hits.begin(), scheduled_hits.end());
+				for (auto hit : discrete_hits)
+				{
+					if (!std::binary_search(scheduled_hits.begin(), scheduled_hits.end(), hit))
+					{
+						missed++;
+					}
+				}
+
+				discrete_hit_count += discrete_hits.size();
+				scheduled_hit_count += scheduled_hits.size();
+			}
+
+			std::cout << std::setw(10) << count << std::setw(12) << tick_rate << std::setw(18) << uint64_t(discrete_time / ticks) << std::setw(18) << uint64_t(scheduled_time / ticks) << std::setw(14) << tests / ticks << std::setw(16) << discrete_hit_count << std::setw(16) << scheduled_hit_count << std::setw(10) << missed << std::endl;
+		}
+	}
+
+	std::cout << std::endl;
+}
+
+// The interface every game object implemented before the entity registry, so per object virtual dispatch can be compared against systems
+class VirtualObject
+{
+public:
+	virtual ~VirtualObject() {}
+	virtual void update(double time) = 0;
+	virtual void submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height, float interpolation) const = 0;
+	virtual void pause() = 0;
+	virtual void unpause() = 0;
+};
+
+// Moves, owns a collider and draws a lit mesh, like an enemy
+class VirtualMover : public VirtualObject
+{
+public:
+	VirtualMover(Renderer *renderer, ColliderRegistry *registry, ColliderID collider, glm::vec2 location, glm::vec2 velocity)
+		: renderer(renderer), registry(registry), collider(collider), location(location), previous_location(location), velocity(velocity)
+	{
+	}
+
+	virtual void update(double time)
+	{
+		previous_location = location;
+		location += float(time) * velocity;
+		registry->get(collider).set_placement(location - glm::vec2(enemy_collider_size / 2.f), glm::vec2(enemy_collider_size));
+	}
+
+	virtual void submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height, float interpolation) const
+	{
+		glm::vec2 draw_location = glm::mix(previous_location, location, interpolation);
+
+		MeshUniform uniform = {};
+		uniform.model = glm::translate(glm::mat4(1), glm::vec3(draw_location.x * width, draw_location.y * height, -0.4f)) * glm::scale(glm::mat4(1), glm::vec3(0.12f));
+		uniform.view = view;
+		uniform.proj = proj;
+		uniform.light_index = -1;
+
+		UniformBufferUpdateParameters update_parameters = {};
+		update_parameters.buffer_name = uniform_buffer;
+		update_parameters.data = &uniform;
+		update_uniform_buffer(*renderer, update_parameters);
+
+		InstanceSubmitParameters submit_parameters = {};
+		submit_parameters.instance_name = instance;
+		submit_instance(*renderer, submit_parameters);
+	}
+
+	virtual void pause() {}
+	virtual void unpause() {}
+
+private:
+	Renderer *renderer;
+	ColliderRegistry *registry;
+	ColliderID collider;
+	glm::vec2 location;
+	glm::vec2 previous_location;
+	glm::vec2 velocity;
+	std::string uniform_buffer;
+	std::string instance;
+};
+
+// What each glyph uploaded before glyphs were batched
+struct VirtualGlyphUniform
+{
+	glm::mat4 model;
+	glm::mat4 view;
+	glm::mat4 proj;
+	float x;
+	float y;
+	float width;
+	float height;
+};
+
+// Sits still and draws one character, like a glyph of text. Its update does nothing but still costs a call.
+class VirtualGlyph : public VirtualObject
+{
+public:
+	VirtualGlyph(Renderer *renderer, glm::vec2 location)
+		: renderer(renderer), location(location)
+	{
+	}
+
+	virtual void update(double time) {}
+
+	virtual void submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height, float interpolation) const
+	{
+		VirtualGlyphUniform uniform = {};
+		uniform.model = glm::translate(glm::mat4(1), glm::vec3(location, 0.f)) * glm::scale(glm::mat4(1), glm::vec3(0.05f, 0.05f, 1.f));
+		uniform.view = view;
+		uniform.proj = proj;
+		uniform.width = 0.05f;
+		uniform.height = 0.05f;
+
+		UniformBufferUpdateParameters update_parameters = {};
+		update_parameters.buffer_name = uniform_buffer;
+		update_parameters.data = &uniform;
+		update_uniform_buffer(*renderer, update_parameters);
+
+		InstanceSubmitParameters submit_parameters = {};
+		submit_parameters.instance_name = instance;
+		submit_instance(*renderer, submit_parameters);
+	}
+
+	virtual void pause() {}
+	virtual void unpause() {}
+
+private:
+	Renderer *renderer;
+	glm::vec2 location;
+	std::string uniform_buffer;
+	std::string instance;
+};
+
+// Runs a tick of updates, collider placement and drawing for a mix of moving meshes and still glyphs,
+// once through a list of virtual objects and once through the entity registry and its systems
+void benchmark_entities()
+{
+	const uint32_t ticks = 200;
+	const double tick_time = 1.0 / 120.0;
+
+	// One object in four moves, the rest are text
+	const uint32_t glyphs_per_mover = 3;
+
+	Renderer renderer = {};
+	RendererParameters renderer_parameters = {};
+	renderer_parameters.backend = RENDERER_BACKEND_NULL;
+	create_renderer(renderer, renderer_parameters);
+
+	JobSystem job_system(1);
+
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 2.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const glm::mat4 proj = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 10.0f);
+
+	std::cout << "Entities: virtual objects vs entity registry systems (null renderer, " << glyphs_per_mover << " glyphs per mover)" << std::endl;
+	std::cout << std::setw(10) << "objects" << std::setw(18) << "virtual ns/tick" << std::setw(18) << "systems ns/tick" << std::setw(10) << "speedup" << std::endl;
+
+	for (uint32_t count : { 100, 1000, 10000, 100000 })
+	{
+		std::mt19937 generator(count);
+		std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+		std::vector<glm::vec2> locations(count);
+		std::vector<glm::vec2> velocities(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			locations[i] = glm::vec2(distribution(generator), distribution(generator));
+			velocities[i] = glm::vec2(distribution(generator), distribution(generator));
+		}
+
+		// Old style: every object behind a pointer, every tick calls update and submit on each one
+		ColliderRegistry virtual_colliders;
+		const uint32_t virtual_owner = virtual_colliders.add_owner();
+		std::vector<VirtualObject *> objects;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (i % (glyphs_per_mover + 1) == 0)
+			{
+				objects.push_back(new VirtualMover(&renderer, &virtual_colliders, virtual_colliders.add(virtual_owner, i, COLLISION_LAYER_ENEMY), locations[i], velocities[i]));
+			}
+			else
+			{
+				objects.push_back(new VirtualGlyph(&renderer, locations[i]));
+			}
+		}
+
+		auto start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t tick = 0; tick < ticks; tick++)
+		{
+			for (auto object : objects)
+			{
+				object->update(tick_time);
+			}
+
+			for (auto object : objects)
+			{
+				object->submit_for_rendering(view, proj, 1.f, 1.f, 0.5f);
+			}
+		}
+
+		auto end_time = std::chrono::high_resolution_clock::now();
+		double virtual_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / ticks;
+
+		for (auto object : objects)
+		{
+			delete object;
+		}
+
+		// New style: components in packed arrays, each system walks only the components it needs
+		ColliderRegistry entity_colliders;
+		const uint32_t entity_owner = entity_colliders.add_owner();
+		EntityRegistry entities;
+		RenderSystem render_system(&renderer, &job_system);
+
+		// Movement isn't a system of its own in the game, so movers keep their velocity alongside their entity like EnemyManager does
+		std::vector<EntityID> movers;
+		std::vector<glm::vec2> mover_velocities;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			EntityID entity = entities.create();
+
+			Transform transform = {};
+			transform.location = locations[i];
+			transform.previous_location = locations[i];
+
+			RenderHandle render = {};
+			render.visible = true;
+
+			if (i % (glyphs_per_mover + 1) == 0)
+			{
+				transform.depth = -0.4f;
+				transform.scale = glm::vec3(0.12f);
+				render.kind = RENDER_KIND_MESH;
+
+				ColliderHandle collider = {};
+				collider.collider = entity_colliders.add(entity_owner, i, COLLISION_LAYER_ENEMY);
+				collider.size = glm::vec2(enemy_collider_size);
+				collider.follow = true;
+				entities.colliders.add(entity, collider);
+
+				movers.push_back(entity);
+				mover_velocities.push_back(velocities[i]);
+			}
+			else
+			{
+				transform.scale = glm::vec3(0.05f, 0.05f, 1.f);
+				render.kind = RENDER_KIND_GLYPH;
+				entities.glyph_quads.add(entity, layout_glyph(transform, glm::vec4(0.f, 0.f, 0.05f, 0.05f)));
+			}
+
+			entities.transforms.add(entity, transform);
+			entities.renders.add(entity, render);
+		}
+
+		start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t tick = 0; tick < ticks; tick++)
+		{
+			for (size_t i = 0; i < movers.size(); i++)
+			{
+				Transform &transform = entities.transforms.get(movers[i]);
+				transform.previous_location = transform.location;
+				transform.location += float(tick_time) * mover_velocities[i];
+			}
+
+			place_colliders(entities, entity_colliders);
+			render_system.submit(entities, view, proj, 1.f, 1.f, 0.5f);
+		}
+
+		end_time = std::chrono::high_resolution_clock::now();
+		double system_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / ticks;
+
+		std::cout << std::setw(10) << count << std::setw(18) << uint64_t(virtual_time) << std::setw(18) << uint64_t(system_time) << std::setw(10) << virtual_time / system_time << std::endl;
+	}
+
+	cleanup_renderer(renderer);
+
+	std::cout << std::endl;
+}
+
+// Keeps a score counter up to date every tick, once formatting it with std::to_string and once through Text::update_number
+void benchmark_hud_text()
+{
+	const uint32_t ticks = 200000;
+	const double tick_time = 1.0 / 120.0;
+
+	EntityRegistry entities;
+	Font font(FONT_ARIAL);
+
+	std::cout << "HUD text: update_string(std::to_string) vs update_number (" << ticks << " ticks)" << std::endl;
+	std::cout << std::setw(10) << "enemies" << std::setw(16) << "string ns/tick" << std::setw(16) << "string allocs" << std::setw(16) << "number ns/tick" << std::setw(16) << "number allocs" << std::endl;
+
+	// The score goes up by the number of enemies every second, so more enemies change the digits more often
+	for (uint32_t enemies : { 1u, 10u, 1000u })
+	{
+		Text string_text(&entities, &font, glm::vec2(-0.5f, 0.93f), 1.0f, "0");
+		Text number_text(&entities, &font, glm::vec2(-0.5f, 0.93f), 1.0f, "0");
+
+		// Make every glyph the final score needs up front, so only steady state updates are counted
+		const std::string final_score = std::to_string(int(ticks * tick_time * enemies));
+		for (Text *text : { &string_text, &number_text })
+		{
+			text->update_string(final_score);
+			text->update_string("0");
+		}
+
+		double score = 0.0;
+		uint64_t allocations = allocation_count;
+		auto start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t tick = 0; tick < ticks; tick++)
+		{
+			score += tick_time * enemies;
+			string_text.update_string(std::to_string(int(score)));
+		}
+
+		auto end_time = std::chrono::high_resolution_clock::now();
+		double string_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / ticks;
+		uint64_t string_allocations = allocation_count - allocations;
+
+		score = 0.0;
+		allocations = allocation_count;
+		start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t tick = 0; tick < ticks; tick++)
+		{
+			score += tick_time * enemies;
+			number_text.update_number(int(score));
+		}
+
+		end_time = std::chrono::high_resolution_clock::now();
+		double number_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / ticks;
+		uint64_t number_allocations = allocation_count - allocations;
+
+		std::cout << std::setw(10) << enemies << std::setw(16) << string_time << std::setw(16) << string_allocations << std::setw(16) << number_time << std::setw(16) << number_allocations << std::endl;
+	}
+
+	std::cout << std::endl;
+}
+
+// Compares building the font by parsing ARIAL.fnt, as every game restart used to, with loading it from the binary cache
+void benchmark_font_loading()
+{
+	const uint32_t loads = 200;
+	const std::string cache_name = "Resources/ARIAL.fnt.cache";
+
+	std::cout << "Font loading: parsing ARIAL.fnt vs the binary cache (" << loads << " loads)" << std::endl;
+	std::cout << std::setw(10) << "source" << std::setw(12) << "us/load" << std::setw(10) << "matches" << std::endl;
+
+	auto time_loads = [&](bool parse)
+	{
+		double total = 0.0;
+
+		for (uint32_t i = 0; i < loads; i++)
+		{
+			// Removing the cache makes the font parse the .fnt and write it again, which is counted too since that's the cost of a load without one
+			if (parse)
+			{
+				std::filesystem::remove(cache_name);
+			}
+
+			auto start_time = std::chrono::high_resolution_clock::now();
+			Font *font = new Font(FONT_ARIAL);
+			auto end_time = std::chrono::high_resolution_clock::now();
+
+			total += std::chrono::duration<double, std::micro>(end_time - start_time).count();
+			delete font;
+		}
+
+		return total / loads;
+	};
+
+	double parse_time = time_loads(true);
+	Font parsed(FONT_ARIAL);
+
+	double cache_time = time_loads(false);
+	Font cached(FONT_ARIAL);
+
+	// Both ways should give exactly the same font
+	bool matches = std::memcmp(parsed.chars, cached.chars, sizeof(parsed.chars)) == 0;
+	for (uint32_t i = 0; i < font_char_count * font_char_count; i++)
+	{
+		matches = matches && parsed.get_kerning(char(i / font_char_count), char(i % font_char_count)) == cached.get_kerning(char(i / font_char_count), char(i % font_char_count));
+	}
+
+	std::cout << std::setw(10) << "fnt" << std::setw(12) << parse_time << std::setw(10) << "-" << std::endl;
+	std::cout << std::setw(10) << "cache" << std::setw(12) << cache_time << std::setw(10) << (matches ? "yes" : "NO") << std::endl;
+
+	std::cout << std::endl;
+}
+
+// Compares finding every uniform buffer by name each frame, as the renderer used to, with reaching it through its handle
+void benchmark_renderer_handles()
+{
+	const uint32_t frames = 2000;
+
+	std::cout << "Renderer lookups: string names vs handles (" << frames << " frames)" << std::endl;
+	std::cout << std::setw(10) << "buffers" << std::setw(14) << "name ns" << std::setw(14) << "handle ns" << std::setw(10) << "speedup" << std::endl;
+
+	for (uint32_t count : { 100u, 1000u, 10000u })
+	{
+		std::unordered_map<std::string, UniformBuffer> named_buffers;
+		std::vector<std::string> names;
+
+		HandleArray<UniformBuffer> buffers;
+		std::vector<UniformBufferID> ids;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			UniformBuffer uniform_buffer = {};
+			uniform_buffer.name = "Uniform_Buffer_" + std::to_string(i);
+			uniform_buffer.buffers.resize(3);
+
+			named_buffers[uniform_buffer.name] = uniform_buffer;
+			names.push_back(uniform_buffer.name);
+			ids.push_back(buffers.add(uniform_buffer));
+		}
+
+		// Every lookup touches the buffer so neither loop can be optimized away
+		size_t name_total = 0;
+		auto start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t frame = 0; frame < frames; frame++)
+		{
+			for (const auto &name : names)
+			{
+				name_total += named_buffers[name].buffers.size();
+			}
+		}
+
+		auto end_time = std::chrono::high_resolution_clock::now();
+		double name_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / (double(frames) * count);
+
+		size_t handle_total = 0;
+		start_time = std::chrono::high_resolution_clock::now();
+
+		for (uint32_t frame = 0; frame < frames; frame++)
+		{
+			for (const auto &id : ids)
+			{
+				handle_total += buffers.get(id).buffers.size();
+			}
+		}
+
+		end_time = std::chrono::high_resolution_clock::now();
+		double handle_time = std::chrono::duration<double, std::nano>(end_time - start_time).count() / (double(frames) * count);
+
+		if (name_total != handle_total)
+		{
+			std::cout << "Lookups found different buffers!" << std::endl;
+		}
+
+		std::cout << std::setw(10) << count << std::setw(14) << name_time << std::setw(14) << handle_time << std::setw(10) << name_time / handle_time << std::endl;
+	}
+
+	std::cout << std::endl;
+}
+
+const std::vector<Benchmark> benchmarks = {
+	{ "broadphase", benchmark_broadphase },
+	{ "aabb", benchmark_aabb_kernel },
+	{ "floor", benchmark_floor_marking },
+	{ "jobs", benchmark_job_scaling },
+	{ "random", benchmark_random },
+	{ "toi", benchmark_collision_scheduling },
+	{ "entities", benchmark_entities },
+	{ "hud", benchmark_hud_text },
+	{ "font", benchmark_font_loading },
+	{ "handles", benchmark_renderer_handles }
+};
+
+int main(int argc, char **argv)
+{
+	// Run every benchmark unless one is named
+	std::string selected = "all";
+
+	if (argc > 1)
+	{
+		selected = argv[1];
+	}
+
+	bool found = false;
+
+	for (const auto &benchmark : benchmarks)
+	{
+		if (selected == "all" || selected == benchmark.name)
+		{
+			benchmark.run();
+			found = true;
+		}
+	}
+
+	if (!found)
+	{
+		std::cout << "Unknown benchmark: " << selected << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
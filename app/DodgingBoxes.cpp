@@ -1,7 +1,11 @@
 #include "Renderer/Renderer.h"
 #include "Player.h"
+#include "FixedTimestep.h"
+#include "InputRecording.h"
 
+#include <cctype>
 #include <chrono>
+#include <cstring>
 #include <iostream>
 #include <time.h>
 #include "Utilities.h"
@@ -28,6 +32,7 @@ const std::vector<std::string> shaders = {
 	"Resources/vert_standard_tex_coord.spv",
 	"Resources/vert_standard_light_index.spv",
 	"Resources/vert_text.spv",
+	"Resources/vert_text_batch.spv",
 	"Resources/frag_pause_screen.spv",
 	"Resources/frag_death_screen.spv",
 	"Resources/frag_red.spv",
@@ -56,8 +61,227 @@ struct UB
 	glm::mat4 proj;
 };
 
-int main()
+// Number of simulated ticks when running headless without a tick count
+const uint64_t default_headless_ticks = 1000000;
+
+// Simulation ticks per second of game time unless set with --tick-rate
+const double default_tick_rate = 120.0;
+
+// Most ticks simulated for one rendered frame. Frames slower than this run the game in slow motion instead of falling further behind.
+const uint32_t max_ticks_per_frame = 8;
+
+// Runs the simulation against the null renderer and audio backends, restarting whenever the player dies
+void run_headless(uint64_t total_ticks, double tick_time, uint32_t seed, CollisionMode collision_mode)
 {
+	SoundManager::select_backend(SOUND_BACKEND_NULL);
+
+	Renderer renderer = {};
+	RendererParameters renderer_parameters = {};
+	renderer_parameters.backend = RENDERER_BACKEND_NULL;
+	renderer_parameters.max_frames = max_frames;
+
+	create_renderer(renderer, renderer_parameters);
+
+	// Every game gets its own seed, drawn from the one for the whole run
+	RandomStream game_seeds(seed);
+
+	GameManager *game_manager = new GameManager(&renderer, width, height, game_seeds.next());
+	game_manager->set_collision_mode(collision_mode);
+	uint64_t games = 1;
+	uint64_t pairs_tested = 0;
+	uint64_t pairs_culled = 0;
+
+	auto start_time = std::chrono::high_resolution_clock::now();
+
+	for (uint64_t tick = 0; tick < total_ticks; tick++)
+	{
+		game_manager->update(tick_time, width, height);
+		game_manager->resolve_collisions();
+
+		pairs_tested += game_manager->get_collision_counters().tested;
+		pairs_culled += game_manager->get_collision_counters().culled;
+
+		if (game_manager->game_is_over())
+		{
+			delete game_manager;
+			SoundManager::get_instance().reset();
+			game_manager = new GameManager(&renderer, width, height, game_seeds.next());
+			game_manager->set_collision_mode(collision_mode);
+			games++;
+		}
+	}
+
+	auto end_time = std::chrono::high_resolution_clock::now();
+	double seconds = std::chrono::duration<double, std::chrono::seconds::period>(end_time - start_time).count();
+
+	delete game_manager;
+
+	cleanup_renderer(renderer);
+
+	std::cout << "Simulated " << total_ticks << " ticks (" << games << " games) in " << seconds << " s" << std::endl;
+	std::cout << "Ticks per second: " << total_ticks / seconds << std::endl;
+	std::cout << "Collider pairs per tick: " << double(pairs_tested) / total_ticks << " tested, " << double(pairs_culled) / total_ticks << " culled" << std::endl;
+}
+
+// Folds a finished game's score into a running FNV-1a hash of the exact bits, so any drift in a replay shows up
+uint64_t fold_score(uint64_t checksum, double score)
+{
+	uint64_t bits;
+	std::memcpy(&bits, &score, sizeof(bits));
+
+	for (int i = 0; i < 8; i++)
+	{
+		checksum ^= (bits >> (i * 8)) & 0xff;
+		checksum *= 0x100000001b3ull;
+	}
+
+	return checksum;
+}
+
+// Feeds a recording back through the simulation headless and prints a checksum of the scores it produced
+void run_replay(const std::string &file_name)
+{
+	InputPlayback playback(file_name);
+
+	SoundManager::select_backend(SOUND_BACKEND_NULL);
+
+	Renderer renderer = {};
+	RendererParameters renderer_parameters = {};
+	renderer_parameters.backend = RENDERER_BACKEND_NULL;
+	renderer_parameters.max_frames = max_frames;
+
+	create_renderer(renderer, renderer_parameters);
+
+	// Same seeds and tick length as the recorded run, so every tick sees exactly what it saw then
+	RandomStream game_seeds(playback.get_seed());
+	const double tick_time = 1.0 / playback.get_tick_rate();
+
+	GameManager *game_manager = new GameManager(&renderer, width, height, game_seeds.next());
+	uint64_t games = 1;
+	uint64_t ticks = 0;
+	uint64_t checksum = 0xcbf29ce484222325ull;
+
+	auto start_time = std::chrono::high_resolution_clock::now();
+
+	Input input;
+	while (!game_manager->should_quit() && playback.next(input))
+	{
+		game_manager->set_input(input);
+		game_manager->update(tick_time, width, height);
+		game_manager->resolve_collisions();
+		ticks++;
+
+		if (game_manager->game_has_ended())
+		{
+			checksum = fold_score(checksum, game_manager->get_score());
+
+			delete game_manager;
+			SoundManager::get_instance().reset();
+			game_manager = new GameManager(&renderer, width, height, game_seeds.next());
+			games++;
+		}
+	}
+
+	auto end_time = std::chrono::high_resolution_clock::now();
+	double seconds = std::chrono::duration<double, std::chrono::seconds::period>(end_time - start_time).count();
+
+	// The game in progress when the recording stopped counts too
+	checksum = fold_score(checksum, game_manager->get_score());
+
+	delete game_manager;
+
+	cleanup_renderer(renderer);
+
+	std::cout << "Replayed " << ticks << " of " << playback.get_tick_count() << " ticks (" << games << " games) in " << seconds << " s" << std::endl;
+	std::cout << "Ticks per second: " << ticks / seconds << std::endl;
+	std::cout << "Score checksum: " << std::hex << checksum << std::dec << std::endl;
+}
+
+void print_usage()
+{
+	std::cout << "Usage: app [--headless [ticks]] [--tick-rate N] [--seed N] [--collision discrete|scheduled] [--record file] [--replay file]" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+	bool headless = false;
+	uint64_t total_ticks = default_headless_ticks;
+	double tick_rate = default_tick_rate;
+	uint32_t seed = time_seed();
+	CollisionMode collision_mode = COLLISION_MODE_DISCRETE;
+	std::string record_file;
+	std::string replay_file;
+
+	for (int i = 1; i < argc; i++)
+	{
+		std::string argument = argv[i];
+
+		if (argument == "--headless")
+		{
+			headless = true;
+
+			// Tick count is optional
+			if (i + 1 < argc && std::isdigit(argv[i + 1][0]))
+			{
+				total_ticks = std::stoull(argv[++i]);
+			}
+		}
+		else if (argument == "--tick-rate" && i + 1 < argc)
+		{
+			tick_rate = std::stod(argv[++i]);
+		}
+		else if (argument == "--seed" && i + 1 < argc)
+		{
+			seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+		}
+		else if (argument == "--collision")
+		{
+			std::string value = i + 1 < argc ? argv[++i] : "";
+
+			if (value == "discrete")
+			{
+				collision_mode = COLLISION_MODE_DISCRETE;
+			}
+			else if (value == "scheduled")
+			{
+				collision_mode = COLLISION_MODE_SCHEDULED;
+			}
+			else
+			{
+				print_usage();
+				return 1;
+			}
+		}
+		else if (argument == "--record" && i + 1 < argc)
+		{
+			record_file = argv[++i];
+		}
+		else if (argument == "--replay" && i + 1 < argc)
+		{
+			replay_file = argv[++i];
+		}
+	}
+
+	if (tick_rate <= 0.0)
+	{
+		print_usage();
+		return 1;
+	}
+
+	// Play a recording back instead of reading the keyboard
+	if (!replay_file.empty())
+	{
+		run_replay(replay_file);
+		return 0;
+	}
+
+	// Run without a window, GPU or audio device if requested
+	if (headless)
+	{
+		run_headless(total_ticks, 1.0 / tick_rate, seed, collision_mode);
+		return 0;
+	}
+
 	// Set up glfw and create window
 	glfwInit();
 
@@ -86,7 +310,17 @@ int main()
 	
 	create_renderer(renderer, renderer_parameters);
 
-	GameManager *game_manager = new GameManager(&renderer, width, height);
+	// Shared by every game for the life of the window
+	JobSystem job_system;
+
+	// Every game's seed comes from the run's seed, so a recording can reproduce every enemy spawn
+	RandomStream game_seeds(seed);
+
+	InputRecorder recorder(seed, tick_rate);
+	bool recording = !record_file.empty();
+
+	GameManager *game_manager = new GameManager(&renderer, width, height, game_seeds.next(), &job_system);
+	FixedTimestep timestep(tick_rate, max_ticks_per_frame);
 
 	uint16_t frame_count = 0;
 
@@ -115,10 +349,30 @@ int main()
 
 		glfwGetFramebufferSize(window, &w, &h);
 
-		game_manager->update(time, w, h);
-		game_manager->resolve_collisions();
+		// Simulate in fixed ticks however long the frame took, then draw between the last two
+		uint32_t ticks = timestep.advance(time);
+		for (uint32_t tick = 0; tick < ticks; tick++)
+		{
+			game_manager->set_input(GameManager::get_keyboard_input());
+
+			if (recording)
+			{
+				recorder.record(game_manager->get_input());
+			}
+
+			game_manager->update(timestep.get_tick_time(), w, h);
+			game_manager->resolve_collisions();
+
+			// Restart on the tick the game ended so a replay restarts at the same point
+			if (game_manager->game_has_ended())
+			{
+				delete game_manager;
+				SoundManager::get_instance().reset();
+				game_manager = new GameManager(&renderer, w, h, game_seeds.next(), &job_system);
+			}
+		}
 
-		game_manager->submit_for_rendering(static_cast<uint32_t>(w), static_cast<uint32_t>(h));
+		game_manager->submit_for_rendering(static_cast<uint32_t>(w), static_cast<uint32_t>(h), timestep.get_interpolation());
 
 		DrawParameters draw_parameters = {};
 		draw_parameters.draw_frame = frame_count;
@@ -130,17 +384,23 @@ int main()
 		{
 			frame_count = 0;
 		}
-
-		if (game_manager->game_has_ended())
-		{
-			delete game_manager;
-			SoundManager::get_instance().reset();
-			game_manager = new GameManager(&renderer, w, h);
-		}
 	}
 
 	delete game_manager;
 
+	if (recording)
+	{
+		recorder.save(record_file);
+	}
+
+	const CommandRecordCounters &record_counters = renderer.record_counters;
+	std::cout << "Render passes recorded: " << record_counters.recorded << ", reused: " << record_counters.reused << std::endl;
+
+	if (record_counters.recorded > 0)
+	{
+		std::cout << "Microseconds per pass recorded: " << 1e6 * record_counters.record_seconds / record_counters.recorded << std::endl;
+	}
+
 	cleanup_renderer(renderer);
 
 	glfwDestroyWindow(renderer.window);
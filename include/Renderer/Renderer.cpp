@@ -9,10 +9,60 @@
 
 const bool enable_validation_layers = true;
 
+// Queues Vulkan objects to be destroyed once the GPU has finished every frame that could use them. That includes the next
+// one, since whatever was submitted for it before the free still gets drawn.
+static PendingDestruction &defer_destruction(Renderer &renderer)
+{
+	// Everything freed before the next submission shares one entry
+	const uint64_t last_frame = renderer.submitted_frames + 1;
+
+	if (renderer.pending_destruction.empty() || renderer.pending_destruction.back().frame != last_frame)
+	{
+		PendingDestruction pending = {};
+		pending.frame = last_frame;
+		renderer.pending_destruction.push_back(pending);
+	}
+
+	return renderer.pending_destruction.back();
+}
+
+// Destroys everything that was freed before finished_frame was submitted
+static void destroy_pending(Renderer &renderer, uint64_t finished_frame)
+{
+	size_t destroyed = 0;
+
+	for (; destroyed < renderer.pending_destruction.size() && renderer.pending_destruction[destroyed].frame <= finished_frame; destroyed++)
+	{
+		PendingDestruction &pending = renderer.pending_destruction[destroyed];
+
+		for (auto &resource : pending.resources)
+		{
+			cleanup_resource(resource);
+		}
+
+		for (auto &buffer : pending.buffers)
+		{
+			cleanup_buffer(buffer);
+		}
+	}
+
+	renderer.pending_destruction.erase(renderer.pending_destruction.begin(), renderer.pending_destruction.begin() + destroyed);
+}
+
 void create_renderer(Renderer &renderer, RendererParameters &parameters)
 {
 	renderer.instances = {};
+	renderer.instance_names = {};
 	renderer.max_frames = parameters.max_frames;
+	renderer.backend = parameters.backend;
+	renderer.image_index = 0;
+
+	// The null backend never touches Vulkan, so every other call becomes a no-op
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		renderer.window = nullptr;
+		return;
+	}
 
 	// Copy window and enable validation layers
 	if (enable_validation_layers) {
@@ -475,7 +525,6 @@ void create_renderer(Renderer &renderer, RendererParameters &parameters)
 	data_manager_parameters.models = models;
 	data_manager_parameters.shaders = shaders;
 	data_manager_parameters.textures = textures;
-	data_manager_parameters.uniform_buffers = {};
 	data_manager_parameters.materials = {};
 
 	create_data_manager(renderer.data, data_manager_parameters);
@@ -750,6 +799,7 @@ void create_renderer(Renderer &renderer, RendererParameters &parameters)
 	VulkanPipeline pipeline_blue = {};
 	VulkanPipeline pipeline_yellow = {};
 	VulkanPipeline pipeline_text = {};
+	VulkanPipeline pipeline_text_batch = {};
 	VulkanPipeline pipeline_volume = {};
 	VulkanPipeline pipeline_darken = {};
 	VulkanPipelineParameters pipeline_parameters = {};
@@ -816,6 +866,11 @@ void create_renderer(Renderer &renderer, RendererParameters &parameters)
 
 	create_pipeline(pipeline_text, pipeline_parameters);
 
+	// Same as text, but with every glyph's position and texture coordinates already in its vertices
+	pipeline_parameters.shaders = { renderer.data.shaders["Resources/vert_text_batch.spv"], renderer.data.shaders["Resources/frag_text.spv"] };
+
+	create_pipeline(pipeline_text_batch, pipeline_parameters);
+
 	pipeline_parameters.attribute_descriptions = attribute_descriptions;
 	pipeline_parameters.binding_descriptions = binding_descriptions;
 	pipeline_parameters.num_textures = 0;
@@ -835,6 +890,7 @@ void create_renderer(Renderer &renderer, RendererParameters &parameters)
 	pipelines.push_back({ "standard_pause", pipeline_pause_screen });
 	pipelines.push_back({ "standard_death", pipeline_death_screen });
 	pipelines.push_back({ "text", pipeline_text });
+	pipelines.push_back({ "text_batch", pipeline_text_batch });
 	pipelines.push_back({ "darken", pipeline_darken });
 
 	// Create pipelines for shadow maps
@@ -1097,6 +1153,16 @@ void create_renderer(Renderer &renderer, RendererParameters &parameters)
 	mat_text.vertex_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].vertex_buffers[mat_text.pipelines[0]] };
 	mat_text.index_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].index_buffers[mat_text.pipelines[0]] };
 
+	// No model, submit_text_batch supplies the batch's own vertex and index buffers
+	Material mat_text_batch = {};
+	mat_text_batch.models = {};
+	mat_text_batch.pipelines = { "text_batch" };
+	mat_text_batch.textures = { {renderer.data.textures["Resources/ARIAL.png"]} };
+	mat_text_batch.use_lights = LIGHT_USAGE_NONE;
+	mat_text_batch.resources = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].resources[mat_text_batch.pipelines[0]] };
+	mat_text_batch.vertex_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].vertex_buffers[mat_text_batch.pipelines[0]] };
+	mat_text_batch.index_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].index_buffers[mat_text_batch.pipelines[0]] };
+
 	Material mat_volume = {};
 	mat_volume.models = { &renderer.data.models["SQUARE"] };
 	mat_volume.pipelines = { "volume" };
@@ -1122,12 +1188,17 @@ void create_renderer(Renderer &renderer, RendererParameters &parameters)
 	mat_darken.vertex_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].vertex_buffers[mat_darken.pipelines[0]] };
 	mat_darken.index_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].index_buffers[mat_darken.pipelines[0]] };
 
-	renderer.data.materials = { mat_pause_screen, mat_death_screen, mat_red_square, mat_blue_cube, mat_yellow_cube, mat_text, mat_volume, mat_darken };
+	renderer.data.materials = { mat_pause_screen, mat_death_screen, mat_red_square, mat_blue_cube, mat_yellow_cube, mat_text, mat_volume, mat_darken, mat_text_batch };
 
 	// Create semaphores/fences
 	renderer.image_available_semaphores.resize(parameters.max_frames);
 	renderer.render_finished_semaphores.resize(parameters.max_frames);
 	renderer.in_flight_fences.resize(parameters.max_frames);
+	renderer.fence_frames.resize(parameters.max_frames, 0);
+	renderer.submitted_frames = 0;
+	renderer.finished_frame = 0;
+	renderer.pending_destruction = {};
+	renderer.record_counters = {};
 	renderer.images_in_flight.resize(renderer.swap_chain.swap_chain_images.size(), VK_NULL_HANDLE);
 
 	VkSemaphoreCreateInfo semaphore_create_info = {};
@@ -1152,11 +1223,12 @@ void create_renderer(Renderer &renderer, RendererParameters &parameters)
 	for (uint32_t i = 0; i < max_lights; i++)
 	{
 		renderer.lights[i] = {};
+		renderer.light_generations[i] = 1;
 	}
 
 	UniformBufferParameters lights_buffer_parameters = {};
 	lights_buffer_parameters.size = sizeof(LightUniformBuffer);
-	renderer.light_buffers = get_uniform_buffer(renderer, lights_buffer_parameters);
+	renderer.light_buffers = create_uniform_buffer(renderer, lights_buffer_parameters);
 
 	// Create buffer for shadow maps
 	for (uint32_t i = 0; i < max_lights; i++)
@@ -1165,23 +1237,23 @@ void create_renderer(Renderer &renderer, RendererParameters &parameters)
 		shadow_map_buffer_parameters.range = sizeof(ShadowMapUniformBuffer);
 		shadow_map_buffer_parameters.size = sizeof(ShadowMapUniformBuffer);
 
-		renderer.shadow_map_buffers[i] = get_uniform_buffer(renderer, shadow_map_buffer_parameters);
+		renderer.shadow_map_buffers[i] = create_uniform_buffer(renderer, shadow_map_buffer_parameters);
 	}
 
 	UniformBufferParameters reflection_map_buffer_parameters = {};
 	reflection_map_buffer_parameters.range = sizeof(ReflectionMapUniformBuffer);
 	reflection_map_buffer_parameters.size = sizeof(ReflectionMapUniformBuffer);
-	renderer.reflection_map_buffer = get_uniform_buffer(renderer, reflection_map_buffer_parameters);
+	renderer.reflection_map_buffer = create_uniform_buffer(renderer, reflection_map_buffer_parameters);
 
 	UniformBufferParameters box_internals_buffer_parameters = {};
 	box_internals_buffer_parameters.range = sizeof(BoxInternalsUniformBuffer);
 	box_internals_buffer_parameters.size = sizeof(BoxInternalsUniformBuffer);
-	renderer.box_internals_buffer = get_uniform_buffer(renderer, box_internals_buffer_parameters);
+	renderer.box_internals_buffer = create_uniform_buffer(renderer, box_internals_buffer_parameters);
 
 	UniformBufferParameters volume_buffer_parameters = {};
 	volume_buffer_parameters.range = sizeof(VolumeUniformBuffer);
 	volume_buffer_parameters.size = sizeof(VolumeUniformBuffer);
-	renderer.volume_buffer = get_uniform_buffer(renderer, volume_buffer_parameters);
+	renderer.volume_buffer = create_uniform_buffer(renderer, volume_buffer_parameters);
 
 	InstanceParameters volume_instance_parameters = {};
 	volume_instance_parameters.light_index = -1;
@@ -1191,8 +1263,82 @@ void create_renderer(Renderer &renderer, RendererParameters &parameters)
 	renderer.volume_instance = create_instance(renderer, volume_instance_parameters);
 }
 
+// Records one render pass's command buffer for the current image. Only the pass itself and the counters are touched.
+// A pass that was given exactly what this image's command buffer was last recorded with is submitted as it is.
+static void record_render_pass(Renderer &renderer, RenderPassManager &render_pass)
+{
+	if (render_pass.recorded_draw_lists.size() != render_pass.pass.command_buffers.size())
+	{
+		render_pass.recorded_draw_lists.assign(render_pass.pass.command_buffers.size(), {});
+		render_pass.recorded.assign(render_pass.pass.command_buffers.size(), false);
+	}
+
+	if (render_pass.recorded[renderer.image_index] && render_pass.draw_list == render_pass.recorded_draw_lists[renderer.image_index])
+	{
+		for (const auto &pipeline : render_pass.pass_pipelines)
+		{
+			render_pass.vertex_buffers[pipeline.first].clear();
+			render_pass.index_buffers[pipeline.first].clear();
+			render_pass.resources[pipeline.first].clear();
+		}
+
+		render_pass.draw_list.clear();
+		renderer.record_counters.reused++;
+		return;
+	}
+
+	// Information grouped according to subpass
+	VulkanRenderPassCommandBufferRecordParameters record_parameters = {};
+	record_parameters.subpasses.resize(render_pass.pass.total_subpasses);
+
+	for (const auto &pipeline : render_pass.pass_pipelines)
+	{
+		record_parameters.subpasses[pipeline.second.subpass].vertex_buffers.emplace_back(render_pass.vertex_buffers[pipeline.first]);
+		record_parameters.subpasses[pipeline.second.subpass].index_buffers.emplace_back(render_pass.index_buffers[pipeline.first]);
+		record_parameters.subpasses[pipeline.second.subpass].resources.push_back(render_pass.resources[pipeline.first]);
+		record_parameters.subpasses[pipeline.second.subpass].pipelines.emplace_back(pipeline.second);
+
+		render_pass.vertex_buffers[pipeline.first].clear();
+		render_pass.index_buffers[pipeline.first].clear();
+		render_pass.resources[pipeline.first].clear();
+	}
+
+	record_parameters.device = renderer.device;
+	record_parameters.swap_chain = renderer.swap_chain;
+	record_parameters.framebuffer_index = renderer.image_index;
+	record_parameters.command_index = renderer.image_index;
+	record_parameters.clear_values = render_pass.clear_values;
+
+	if (render_pass.pass.framebuffers.size() == 1)
+	{
+		record_parameters.framebuffer_index = 0;
+	}
+
+	if (render_pass.mip_map)
+	{
+		record_parameters.mip_parameters = render_pass.mip_parameters;
+		record_parameters.flags = COMMAND_RECORD_GENERATE_MIPMAPS;
+	}
+
+	auto record_start = std::chrono::high_resolution_clock::now();
+	record_render_pass_command_buffers(render_pass.pass, record_parameters);
+	auto record_end = std::chrono::high_resolution_clock::now();
+
+	renderer.record_counters.record_seconds += std::chrono::duration<double, std::chrono::seconds::period>(record_end - record_start).count();
+
+	std::swap(render_pass.recorded_draw_lists[renderer.image_index], render_pass.draw_list);
+	render_pass.draw_list.clear();
+	render_pass.recorded[renderer.image_index] = true;
+	renderer.record_counters.recorded++;
+}
+
 void draw(Renderer &renderer, DrawParameters &parameters)
 {
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
 	VolumeUniformBuffer volume_data = {};
 	volume_data.model = glm::scale(glm::translate(glm::mat4(1), glm::vec3(0.0, 0.0, -0.5)), glm::vec3(2.071, 2.071, 1.0));
 	volume_data.view = glm::lookAt(glm::vec3(0.0, 0.0, 2.0), glm::vec3(0.0, 0.0, 0.0), glm::vec3(0.0, 1.0, 0.0));
@@ -1200,13 +1346,13 @@ void draw(Renderer &renderer, DrawParameters &parameters)
 	volume_data.proj[1][1] *= -1;
 
 	UniformBufferUpdateParameters volume_update_parameters = {};
-	volume_update_parameters.buffer_name = renderer.volume_buffer;
+	volume_update_parameters.buffer = renderer.volume_buffer;
 	volume_update_parameters.data = &volume_data;
 
 	update_uniform_buffer(renderer, volume_update_parameters);
 
 	InstanceSubmitParameters volume_submit_parameters = {};
-	volume_submit_parameters.instance_name = renderer.volume_instance;
+	volume_submit_parameters.instance = renderer.volume_instance;
 	submit_instance(renderer, volume_submit_parameters);
 
 	// Update uniform buffer for creating shadow maps
@@ -1245,7 +1391,7 @@ void draw(Renderer &renderer, DrawParameters &parameters)
 		}
 
 		UniformBufferUpdateParameters update_parameters = {};
-		update_parameters.buffer_name = renderer.shadow_map_buffers[j];
+		update_parameters.buffer = renderer.shadow_map_buffers[j];
 		update_parameters.data = &renderer.shadow_map_uniform;
 
 		update_uniform_buffer(renderer, update_parameters);
@@ -1264,58 +1410,16 @@ void draw(Renderer &renderer, DrawParameters &parameters)
 	}
 
 	UniformBufferUpdateParameters lights_buffer_update_parameters = {};
-	lights_buffer_update_parameters.buffer_name = renderer.light_buffers;
+	lights_buffer_update_parameters.buffer = renderer.light_buffers;
 	lights_buffer_update_parameters.data = &lights_data;
 	update_uniform_buffer(renderer, lights_buffer_update_parameters);
 
-	// Record command buffers
-	std::vector<std::pair<VulkanRenderPass*, std::vector<Instance*>>> pass_instances;
-
+	// Record command buffers, now that the GPU is done with this image's ones
 	for (auto &render_pass : renderer.render_passes)
 	{
-		// Information grouped according to subpass
-		VulkanRenderPassCommandBufferRecordParameters record_parameters = {};
-		record_parameters.subpasses.resize(render_pass.pass.total_subpasses);
-
-		for (const auto &pipeline : render_pass.pass_pipelines)
-		{
-			record_parameters.subpasses[pipeline.second.subpass].vertex_buffers.emplace_back(render_pass.vertex_buffers[pipeline.first]);
-			record_parameters.subpasses[pipeline.second.subpass].index_buffers.emplace_back(render_pass.index_buffers[pipeline.first]);
-			record_parameters.subpasses[pipeline.second.subpass].resources.push_back(render_pass.resources[pipeline.first]);
-			record_parameters.subpasses[pipeline.second.subpass].pipelines.emplace_back(pipeline.second);
-
-			render_pass.vertex_buffers[pipeline.first].clear();
-			render_pass.index_buffers[pipeline.first].clear();
-			render_pass.resources[pipeline.first].clear();
-		}
-
-		record_parameters.device = renderer.device;
-		record_parameters.swap_chain = renderer.swap_chain;
-		record_parameters.framebuffer_index = renderer.image_index;
-		record_parameters.command_index = renderer.image_index;
-		record_parameters.clear_values = render_pass.clear_values;
-
-		if (render_pass.pass.framebuffers.size() == 1)
-		{
-			record_parameters.framebuffer_index = 0;
-		}
-
-		if (render_pass.mip_map)
-		{
-			record_parameters.mip_parameters = render_pass.mip_parameters;
-			record_parameters.flags = COMMAND_RECORD_GENERATE_MIPMAPS;
-		}
-
-		record_render_pass_command_buffers(render_pass.pass, record_parameters);
+		record_render_pass(renderer, render_pass);
 	}
 
-	vkWaitForFences(renderer.device.device, 1, &renderer.in_flight_fences[parameters.draw_frame], VK_TRUE, UINT64_MAX);
-
-	if (renderer.images_in_flight[renderer.image_index] != VK_NULL_HANDLE) {
-		vkWaitForFences(renderer.device.device, 1, &renderer.images_in_flight[renderer.image_index], VK_TRUE, UINT64_MAX);
-	}
-	renderer.images_in_flight[renderer.image_index] = renderer.in_flight_fences[parameters.draw_frame];
-
 	VkSubmitInfo submit_info = {};
 	submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
@@ -1345,6 +1449,9 @@ void draw(Renderer &renderer, DrawParameters &parameters)
 		throw std::runtime_error("Failed to submit draw command buffer!");
 	}
 
+	renderer.submitted_frames++;
+	renderer.fence_frames[parameters.draw_frame] = renderer.submitted_frames;
+
 	VkPresentInfoKHR present_info = {};
 	present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 
@@ -1370,6 +1477,17 @@ void draw(Renderer &renderer, DrawParameters &parameters)
 
 void update_image_index(Renderer &renderer, uint32_t draw_frame)
 {
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
+	vkWaitForFences(renderer.device.device, 1, &renderer.in_flight_fences[draw_frame], VK_TRUE, UINT64_MAX);
+
+	// The queue runs frames in order, so every frame up to the one this fence was submitted with is done
+	renderer.finished_frame = std::max(renderer.finished_frame, renderer.fence_frames[draw_frame]);
+	destroy_pending(renderer, renderer.finished_frame);
+
 	// Get image to draw to
 	VkResult result = vkAcquireNextImageKHR(renderer.device.device, renderer.swap_chain.swap_chain, UINT64_MAX, renderer.image_available_semaphores[draw_frame], VK_NULL_HANDLE, &renderer.image_index);
 
@@ -1380,10 +1498,21 @@ void update_image_index(Renderer &renderer, uint32_t draw_frame)
 	else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
 		throw std::runtime_error("Failed to acquire swap chain image!");
 	}
+
+	// Wait here rather than in draw, so nothing written for this image until then, uniforms or text vertices, lands while the GPU still reads it
+	if (renderer.images_in_flight[renderer.image_index] != VK_NULL_HANDLE) {
+		vkWaitForFences(renderer.device.device, 1, &renderer.images_in_flight[renderer.image_index], VK_TRUE, UINT64_MAX);
+	}
+	renderer.images_in_flight[renderer.image_index] = renderer.in_flight_fences[draw_frame];
 }
 
 void update_reflection_map(Renderer &renderer, glm::vec3 location)
 {
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
 	// Update reflection map uniform buffer
 	{
 		ReflectionMapUniformBuffer uniform_data = {};
@@ -1397,7 +1526,7 @@ void update_reflection_map(Renderer &renderer, glm::vec3 location)
 		uniform_data.view[5] = glm::lookAt(location, glm::vec3(location.x, location.y, location.z - 1.0), glm::vec3(0.0, -1.0, 0.0));
 
 		UniformBufferUpdateParameters update_parameters = {};
-		update_parameters.buffer_name = renderer.reflection_map_buffer;
+		update_parameters.buffer = renderer.reflection_map_buffer;
 		update_parameters.data = &uniform_data;
 
 		update_uniform_buffer(renderer, update_parameters);
@@ -1441,7 +1570,7 @@ void update_reflection_map(Renderer &renderer, glm::vec3 location)
 		uniform_data.view[5] = glm::lookAt(glm::vec3(location.x, location.y, location.z - 0.3), glm::vec3(location.x, location.y, location.z + 1.0), glm::vec3(0.0, 1.0, 0.0));
 
 		UniformBufferUpdateParameters update_parameters = {};
-		update_parameters.buffer_name = renderer.box_internals_buffer;
+		update_parameters.buffer = renderer.box_internals_buffer;
 		update_parameters.data = &uniform_data;
 
 		update_uniform_buffer(renderer, update_parameters);
@@ -1450,8 +1579,16 @@ void update_reflection_map(Renderer &renderer, glm::vec3 location)
 
 void cleanup_renderer(Renderer &renderer)
 {
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		renderer = {};
+		return;
+	}
+
 	vkDeviceWaitIdle(renderer.device.device);
 
+	destroy_pending(renderer, UINT64_MAX);
+
 	for (size_t i = 0; i < renderer.max_frames; i++)
 	{
 		vkDestroySemaphore(renderer.device.device, renderer.render_finished_semaphores[i], nullptr);
@@ -1464,13 +1601,23 @@ void cleanup_renderer(Renderer &renderer)
 		cleanup_render_pass_manager(renderer, render_pass);
 	}
 
-	for (auto &instance : renderer.instances)
+	renderer.instances.for_each([](Instance &instance)
 	{
-		for (auto &resource : instance.second.resources)
+		for (auto &resource : instance.resources)
 		{
 			cleanup_resource(resource);
 		}
-	}
+	});
+
+	// Their instances and uniform buffers were cleaned up with the rest
+	renderer.text_batches.for_each([&](TextBatch &text_batch)
+	{
+		for (auto &vertex_buffer : text_batch.vertex_buffers)
+		{
+			cleanup_buffer(vertex_buffer);
+		}
+		cleanup_buffer(text_batch.index_buffer);
+	});
 	
 	cleanup_data_manager(renderer, renderer.data);
 
@@ -1483,8 +1630,13 @@ void cleanup_renderer(Renderer &renderer)
 	renderer = {};
 }
 
-std::string get_uniform_buffer(Renderer &renderer, UniformBufferParameters &parameters)
+UniformBufferID create_uniform_buffer(Renderer &renderer, UniformBufferParameters &parameters)
 {
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return {};
+	}
+
 	// Generate name
 	auto num_uniforms = renderer.data.uniform_buffers.size();
 	std::string name = "Uniform_Buffer_" + std::to_string(num_uniforms);
@@ -1495,7 +1647,7 @@ std::string get_uniform_buffer(Renderer &renderer, UniformBufferParameters &para
 		range = parameters.size;
 	}
 
-	while (renderer.data.uniform_buffers.find(name) != renderer.data.uniform_buffers.end())
+	while (renderer.data.uniform_buffer_names.find(name) != renderer.data.uniform_buffer_names.end())
 	{
 		name += ("_" + std::to_string(num_uniforms));
 	}
@@ -1520,46 +1672,91 @@ std::string get_uniform_buffer(Renderer &renderer, UniformBufferParameters &para
 	uniform_buffer.buffers = buffers;
 	uniform_buffer.name = name;
 
-	renderer.data.uniform_buffers[name] = uniform_buffer;
+	UniformBufferID id = renderer.data.uniform_buffers.add(uniform_buffer);
+	renderer.data.uniform_buffer_names[name] = id;
+
+	return id;
+}
+
+std::string get_uniform_buffer(Renderer &renderer, UniformBufferParameters &parameters)
+{
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return "Uniform_Buffer_Null";
+	}
 
-	return name;
+	return renderer.data.uniform_buffers.get(create_uniform_buffer(renderer, parameters)).name;
+}
+
+UniformBufferID find_uniform_buffer(Renderer &renderer, const std::string &buffer_name)
+{
+	auto id = renderer.data.uniform_buffer_names.find(buffer_name);
+	if (id == renderer.data.uniform_buffer_names.end())
+	{
+		throw std::runtime_error("Could not find uniform buffer " + buffer_name + "!");
+	}
+
+	return id->second;
 }
 
 void update_uniform_buffer(Renderer &renderer, UniformBufferUpdateParameters &parameters)
 {
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
+	UniformBufferID id = parameters.buffer.generation != 0 ? parameters.buffer : find_uniform_buffer(renderer, parameters.buffer_name);
+	VulkanBuffer &buffer = renderer.data.uniform_buffers.get(id).buffers[renderer.image_index];
+
 	// Copy data
 	VulkanBufferDataParameters data_parameters = {};
 	data_parameters.data = parameters.data;
 	data_parameters.device = renderer.device;
-	data_parameters.size = static_cast<uint32_t>(renderer.data.uniform_buffers[parameters.buffer_name].buffers[renderer.image_index].size);
+	data_parameters.size = static_cast<uint32_t>(buffer.size);
 	data_parameters.offset = 0;
-	copy_data_visible_buffer(renderer.data.uniform_buffers[parameters.buffer_name].buffers[renderer.image_index], data_parameters);
+	copy_data_visible_buffer(buffer, data_parameters);
 }
 
-void free_uniform_buffer(Renderer &renderer, std::string uniform_buffer_name)
+void free_uniform_buffer(Renderer &renderer, UniformBufferID buffer)
 {
-	UniformBuffer uniform_buffer = renderer.data.uniform_buffers[uniform_buffer_name];
-	std::string name = uniform_buffer.name;
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
 
-	vkDeviceWaitIdle(renderer.device.device);
+	UniformBuffer &uniform_buffer = renderer.data.uniform_buffers.get(buffer);
+
+	// Frames in flight may still read it
+	PendingDestruction &pending = defer_destruction(renderer);
+	pending.buffers.insert(pending.buffers.end(), uniform_buffer.buffers.begin(), uniform_buffer.buffers.end());
+
+	renderer.data.uniform_buffer_names.erase(uniform_buffer.name);
+	renderer.data.uniform_buffers.remove(buffer);
+}
 
-	for (auto &buffer : uniform_buffer.buffers)
+void free_uniform_buffer(Renderer &renderer, std::string buffer_name)
+{
+	if (renderer.backend == RENDERER_BACKEND_NULL)
 	{
-		cleanup_buffer(buffer);
+		return;
 	}
 
-	uniform_buffer = {};
-
-	renderer.data.uniform_buffers.erase(name);
+	free_uniform_buffer(renderer, find_uniform_buffer(renderer, buffer_name));
 }
 
-std::string create_instance(Renderer &renderer, InstanceParameters &parameters)
+InstanceID create_instance(Renderer &renderer, InstanceParameters &parameters)
 {
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return {};
+	}
+
 	// Find pipeline
 	Material mat = renderer.data.materials[parameters.material];
 
 	std::vector<VulkanPipeline> chosen_pipelines(mat.pipelines.size());
-	uint32_t render_pass_index = 0;
+	std::vector<uint32_t> render_pass_indices(mat.pipelines.size());
 	for (uint32_t k = 0; k < mat.pipelines.size(); k++)
 	{
 		for (uint32_t i = 0; i < renderer.render_passes.size(); i++)
@@ -1571,7 +1768,7 @@ std::string create_instance(Renderer &renderer, InstanceParameters &parameters)
 				{
 
 					chosen_pipelines[k] = pipeline.second;
-					render_pass_index = i;
+					render_pass_indices[k] = i;
 					break;
 				}
 			}
@@ -1594,7 +1791,7 @@ std::string create_instance(Renderer &renderer, InstanceParameters &parameters)
 	for (const auto &uniform_buffers : parameters.uniform_buffers)
 	{
 		for (const auto &uniform_buffer : uniform_buffers)
-		name += "_" + uniform_buffer;
+		name += "_" + renderer.data.uniform_buffers.get(uniform_buffer).name;
 	}
 
 	// Make sure resource of this description doesn't already exist
@@ -1628,7 +1825,7 @@ std::string create_instance(Renderer &renderer, InstanceParameters &parameters)
 			// Submit just the normal uniform buffers
 			for (uint32_t j = 0; j < parameters.uniform_buffers[i].size(); j++)
 			{
-				resource_parameters.uniform_buffers.push_back(renderer.data.uniform_buffers[parameters.uniform_buffers[i][j]].buffers);
+				resource_parameters.uniform_buffers.push_back(renderer.data.uniform_buffers.get(parameters.uniform_buffers[i][j]).buffers);
 			}
 		}
 		else if (mat.use_lights == LIGHT_USAGE_ALL && mat.pipelines[i].substr(0, 6) != "SHADOW")
@@ -1636,14 +1833,14 @@ std::string create_instance(Renderer &renderer, InstanceParameters &parameters)
 			// Otherwise also use the uniform buffer with lighting information
 			for (uint32_t j = 0; j < parameters.uniform_buffers[i].size(); j++)
 			{
-				resource_parameters.uniform_buffers.push_back(renderer.data.uniform_buffers[parameters.uniform_buffers[i][j]].buffers);
+				resource_parameters.uniform_buffers.push_back(renderer.data.uniform_buffers.get(parameters.uniform_buffers[i][j]).buffers);
 			}
-			resource_parameters.uniform_buffers.push_back({ renderer.data.uniform_buffers[renderer.light_buffers].buffers });
+			resource_parameters.uniform_buffers.push_back({ renderer.data.uniform_buffers.get(renderer.light_buffers).buffers });
 		}
 		else if (mat.pipelines[i].substr(0, 6) == "SHADOW")
 		{
 			// If this pipeline is for shadow maps, use that uniform buffer
-			resource_parameters.uniform_buffers = { (renderer.data.uniform_buffers[parameters.uniform_buffers[0][0]].buffers) ,  renderer.data.uniform_buffers[renderer.shadow_map_buffers[shadow_index]].buffers };
+			resource_parameters.uniform_buffers = { (renderer.data.uniform_buffers.get(parameters.uniform_buffers[0][0]).buffers) ,  renderer.data.uniform_buffers.get(renderer.shadow_map_buffers[shadow_index]).buffers };
 			shadow_index++;
 			resource_parameters.textures = {};
 		}
@@ -1651,11 +1848,11 @@ std::string create_instance(Renderer &renderer, InstanceParameters &parameters)
 		// If this pipeline is reflecting, add the reflection ubo
 		if (mat.pipelines[i].substr(0, 7) == "REFLECT")
 		{
-			resource_parameters.uniform_buffers.insert(resource_parameters.uniform_buffers.begin() + 1, renderer.data.uniform_buffers[renderer.reflection_map_buffer].buffers);
+			resource_parameters.uniform_buffers.insert(resource_parameters.uniform_buffers.begin() + 1, renderer.data.uniform_buffers.get(renderer.reflection_map_buffer).buffers);
 		}
 		else if (mat.pipelines[i] == "BOX_INTERNALS")
 		{
-			resource_parameters.uniform_buffers[0] = renderer.data.uniform_buffers[renderer.box_internals_buffer].buffers;
+			resource_parameters.uniform_buffers[0] = renderer.data.uniform_buffers.get(renderer.box_internals_buffer).buffers;
 			resource_parameters.textures = {};
 		}
 
@@ -1664,16 +1861,37 @@ std::string create_instance(Renderer &renderer, InstanceParameters &parameters)
 	}
 
 	Instance instance = {};
+	instance.name = name;
 	instance.resources = resources;
 	instance.material = parameters.material;
+	instance.render_passes = render_pass_indices;
+
+	InstanceID id = renderer.instances.add(instance);
+	renderer.instance_names[name] = id;
 
-	renderer.instances[name] = instance;
-	return name;
+	return id;
+}
+
+InstanceID find_instance(Renderer &renderer, const std::string &instance_name)
+{
+	auto id = renderer.instance_names.find(instance_name);
+	if (id == renderer.instance_names.end())
+	{
+		throw std::runtime_error("Could not find instance " + instance_name + "!");
+	}
+
+	return id->second;
 }
 
 void submit_instance(Renderer &renderer, InstanceSubmitParameters &parameters)
 {
-	const Instance &instance = renderer.instances[parameters.instance_name];
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
+	InstanceID id = parameters.instance.generation != 0 ? parameters.instance : find_instance(renderer, parameters.instance_name);
+	const Instance &instance = renderer.instances.get(id);
 	Material &material = renderer.data.materials[instance.material];
 
 	// Note: instance.resources must be the same size as material.resources
@@ -1682,21 +1900,211 @@ void submit_instance(Renderer &renderer, InstanceSubmitParameters &parameters)
 		material.resources[i]->push_back(instance.resources[i]);
 		material.vertex_buffers[i]->push_back(material.models[i]->first);
 		material.index_buffers[i]->push_back(material.models[i]->second);
+		renderer.render_passes[instance.render_passes[i]].draw_list.push_back({ id, i });
 	}
 }
 
+void free_instance(Renderer &renderer, InstanceID instance)
+{
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
+	// Frames in flight may still bind its descriptor sets
+	auto &freed_instance = renderer.instances.get(instance);
+	PendingDestruction &pending = defer_destruction(renderer);
+	pending.resources.insert(pending.resources.end(), freed_instance.resources.begin(), freed_instance.resources.end());
+
+	// Another instance made with the same name may have replaced this one in the lookup
+	auto name = renderer.instance_names.find(freed_instance.name);
+	if (name != renderer.instance_names.end() && name->second.index == instance.index && name->second.generation == instance.generation)
+	{
+		renderer.instance_names.erase(name);
+	}
+
+	renderer.instances.remove(instance);
+}
+
 void free_instance(Renderer &renderer, std::string instance_name)
 {
-	auto &instance = renderer.instances[instance_name];
-	for (auto &resource : instance.resources)
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
+	free_instance(renderer, find_instance(renderer, instance_name));
+}
+
+TextBatchID create_text_batch(Renderer &renderer, TextBatchParameters &parameters)
+{
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return {};
+	}
+
+	TextBatch batch = {};
+	batch.max_glyphs = parameters.max_glyphs;
+
+	// View and projection are shared by every glyph, everything else is in the vertices
+	UniformBufferParameters uniform_parameters = {};
+	uniform_parameters.size = sizeof(TextBatchUniformBuffer);
+	batch.uniform_buffer = create_uniform_buffer(renderer, uniform_parameters);
+
+	InstanceParameters instance_parameters = {};
+	instance_parameters.material = MATERIAL_TEXT_BATCH;
+	instance_parameters.uniform_buffers = { { batch.uniform_buffer } };
+	batch.instance = create_instance(renderer, instance_parameters);
+
+	// Vertices are rewritten every frame, so keep one host visible buffer per swap chain image
+	VulkanBufferParameters vertex_buffer_parameters = {};
+	vertex_buffer_parameters.device = renderer.device;
+	vertex_buffer_parameters.memory_manager = &(renderer.memory_manager);
+	vertex_buffer_parameters.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+	vertex_buffer_parameters.properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+	vertex_buffer_parameters.range = sizeof(TextVertex);
+	vertex_buffer_parameters.size = sizeof(TextVertex) * 4 * parameters.max_glyphs;
+
+	batch.vertex_buffers.resize(renderer.swap_chain.swap_chain_images.size());
+	for (auto &vertex_buffer : batch.vertex_buffers)
+	{
+		create_buffer(vertex_buffer, vertex_buffer_parameters);
+	}
+
+	// Indices never change. Quads past the glyphs in use are left with every corner at the origin, so they draw nothing.
+	batch.empty_vertices.resize(4 * size_t(parameters.max_glyphs));
+	batch.written_glyphs.resize(batch.vertex_buffers.size(), 0);
+
+	std::vector<uint32_t> indices_data(6 * size_t(parameters.max_glyphs));
+	for (uint32_t i = 0; i < parameters.max_glyphs; i++)
+	{
+		const uint32_t corner = 4 * i;
+		indices_data[6 * i + 0] = corner + 0;
+		indices_data[6 * i + 1] = corner + 1;
+		indices_data[6 * i + 2] = corner + 2;
+		indices_data[6 * i + 3] = corner + 2;
+		indices_data[6 * i + 4] = corner + 3;
+		indices_data[6 * i + 5] = corner + 0;
+	}
+
+	VulkanBufferParameters index_buffer_parameters = {};
+	index_buffer_parameters.data = (void *)indices_data.data();
+	index_buffer_parameters.device = renderer.device;
+	index_buffer_parameters.memory_manager = &(renderer.memory_manager);
+	index_buffer_parameters.range = sizeof(uint32_t);
+	index_buffer_parameters.size = sizeof(uint32_t) * indices_data.size();
+	index_buffer_parameters.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+	index_buffer_parameters.properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+	create_buffer(batch.index_buffer, index_buffer_parameters);
+
+	// Clear every vertex buffer so unused quads start out empty
+	VulkanBufferDataParameters data_parameters = {};
+	data_parameters.data = batch.empty_vertices.data();
+	data_parameters.device = renderer.device;
+	data_parameters.size = static_cast<uint32_t>(sizeof(TextVertex) * batch.empty_vertices.size());
+	data_parameters.offset = 0;
+
+	for (auto &vertex_buffer : batch.vertex_buffers)
+	{
+		copy_data_visible_buffer(vertex_buffer, data_parameters);
+	}
+
+	return renderer.text_batches.add(batch);
+}
+
+void update_text_batch(Renderer &renderer, TextBatchUpdateParameters &parameters)
+{
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
+	TextBatch &batch = renderer.text_batches.get(parameters.batch);
+
+	if (parameters.glyph_count > batch.max_glyphs)
+	{
+		throw std::runtime_error("Too many glyphs for text batch!");
+	}
+
+	TextBatchUniformBuffer uniform_data = {};
+	uniform_data.view = parameters.view;
+	uniform_data.proj = parameters.proj;
+
+	UniformBufferUpdateParameters uniform_update_parameters = {};
+	uniform_update_parameters.buffer = batch.uniform_buffer;
+	uniform_update_parameters.data = &uniform_data;
+	update_uniform_buffer(renderer, uniform_update_parameters);
+
+	// The glyphs were laid out by whoever owns them, so they're copied straight in
+	VulkanBufferDataParameters data_parameters = {};
+	data_parameters.device = renderer.device;
+
+	if (parameters.glyph_count > 0)
 	{
-		cleanup_resource(resource);
+		data_parameters.data = (void *)parameters.vertices;
+		data_parameters.size = static_cast<uint32_t>(sizeof(TextVertex) * 4 * parameters.glyph_count);
+		data_parameters.offset = 0;
+		copy_data_visible_buffer(batch.vertex_buffers[renderer.image_index], data_parameters);
 	}
-	renderer.instances.erase(instance_name);
+
+	// Collapse any quads this image's buffer still has from a frame with more glyphs
+	uint32_t &written_glyphs = batch.written_glyphs[renderer.image_index];
+
+	if (written_glyphs > parameters.glyph_count)
+	{
+		data_parameters.data = batch.empty_vertices.data();
+		data_parameters.size = static_cast<uint32_t>(sizeof(TextVertex) * 4 * (written_glyphs - parameters.glyph_count));
+		data_parameters.offset = static_cast<uint32_t>(sizeof(TextVertex) * 4 * parameters.glyph_count);
+		copy_data_visible_buffer(batch.vertex_buffers[renderer.image_index], data_parameters);
+	}
+
+	written_glyphs = parameters.glyph_count;
 }
 
-uint8_t create_light(Renderer &renderer, LightParameters &parameters)
+void submit_text_batch(Renderer &renderer, TextBatchID batch_id)
 {
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
+	const TextBatch &batch = renderer.text_batches.get(batch_id);
+	const Instance &instance = renderer.instances.get(batch.instance);
+	Material &material = renderer.data.materials[instance.material];
+
+	material.resources[0]->push_back(instance.resources[0]);
+	material.vertex_buffers[0]->push_back(batch.vertex_buffers[renderer.image_index]);
+	material.index_buffers[0]->push_back(batch.index_buffer);
+	renderer.render_passes[instance.render_passes[0]].draw_list.push_back({ batch.instance, 0 });
+}
+
+void free_text_batch(Renderer &renderer, TextBatchID batch_id)
+{
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
+	TextBatch &batch = renderer.text_batches.get(batch_id);
+
+	PendingDestruction &pending = defer_destruction(renderer);
+	pending.buffers.insert(pending.buffers.end(), batch.vertex_buffers.begin(), batch.vertex_buffers.end());
+	pending.buffers.push_back(batch.index_buffer);
+
+	free_instance(renderer, batch.instance);
+	free_uniform_buffer(renderer, batch.uniform_buffer);
+
+	renderer.text_batches.remove(batch_id);
+}
+
+LightID create_light(Renderer &renderer, LightParameters &parameters)
+{
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return {};
+	}
+
 	// Initialize value (so compiler doesn't complain)
 	Light *light = &renderer.lights[0];
 	uint8_t light_index = max_lights + 1;
@@ -1725,15 +2133,31 @@ uint8_t create_light(Renderer &renderer, LightParameters &parameters)
 	light->location = parameters.location;
 	light->type = parameters.type;
 
-	return light_index;
+	return { light_index, renderer.light_generations[light_index] };
+}
+
+// Finds the light a handle refers to, as long as it hasn't been freed since
+static Light *get_light(Renderer &renderer, LightID light)
+{
+	if (light.index >= max_lights || !renderer.lights[light.index].active || renderer.light_generations[light.index] != light.generation)
+	{
+		return nullptr;
+	}
+
+	return &renderer.lights[light.index];
 }
 
 void update_light(Renderer &renderer, LightUpdateParameters &parameters)
 {
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
 	// Retrieve light
-	Light *light = &renderer.lights[parameters.light_index];
+	Light *light = get_light(renderer, parameters.light);
 
-	if (!light->active)
+	if (light == nullptr)
 	{
 		throw std::runtime_error("Tried to update an inactive light!");
 	}
@@ -1745,18 +2169,30 @@ void update_light(Renderer &renderer, LightUpdateParameters &parameters)
 	light->location = parameters.location;
 }
 
-void free_light(Renderer &renderer, uint8_t light_index)
+void free_light(Renderer &renderer, LightID light_id)
 {
+	if (renderer.backend == RENDERER_BACKEND_NULL)
+	{
+		return;
+	}
+
 	// Retrieve light
-	Light *light = &renderer.lights[light_index];
+	Light *light = get_light(renderer, light_id);
 
-	if (!light->active)
+	if (light == nullptr)
 	{
 		throw std::runtime_error("Tried to free an inactive light!");
 	}
 
-	// Set inactive
+	// Set inactive, and stop handles to it reaching whichever light takes the slot next
 	light->active = 0;
+
+	uint32_t &generation = renderer.light_generations[light_id.index];
+	generation++;
+	if (generation == 0)
+	{
+		generation = 1;
+	}
 }
 
 void create_data_manager(DataManager &data_manager, DataManagerParameters &data_manager_parameters)
@@ -1765,7 +2201,8 @@ void create_data_manager(DataManager &data_manager, DataManagerParameters &data_
 	data_manager.models = data_manager_parameters.models;
 	data_manager.shaders = data_manager_parameters.shaders;
 	data_manager.textures = data_manager_parameters.textures;
-	data_manager.uniform_buffers = data_manager_parameters.uniform_buffers;
+	data_manager.uniform_buffers = {};
+	data_manager.uniform_buffer_names = {};
 	data_manager.materials = data_manager_parameters.materials;
 }
 
@@ -1804,17 +2241,13 @@ void cleanup_data_manager(Renderer &renderer, DataManager &data_manager)
 		cleanup_texture(texture.second);
 	}
 
-	for (auto &uniform_buffer : data_manager.uniform_buffers)
+	data_manager.uniform_buffers.for_each([](UniformBuffer &uniform_buffer)
 	{
-		std::string name = uniform_buffer.second.name;
-
-		for (auto &buffer : uniform_buffer.second.buffers)
+		for (auto &buffer : uniform_buffer.buffers)
 		{
 			cleanup_buffer(buffer);
 		}
-
-		uniform_buffer.second = {};
-	}
+	});
 
 	data_manager = {};
 }
@@ -1833,7 +2266,6 @@ void create_render_pass_manager(RenderPassManager &render_pass_manager, RenderPa
 
 void cleanup_render_pass_manager(Renderer &renderer, RenderPassManager &render_pass_manager)
 {
-	vkDeviceWaitIdle(render_pass_manager.pass.device);
 	cleanup_render_pass_command_buffers(render_pass_manager.pass);
 
 	for (auto &pipeline : render_pass_manager.pass_pipelines)
@@ -1857,6 +2289,9 @@ void resize_swap_chain(Renderer &renderer)
 
 	vkDeviceWaitIdle(renderer.device.device);
 
+	// Nothing is in flight, so whatever was waiting can go now
+	destroy_pending(renderer, UINT64_MAX);
+
 	for (uint32_t i = 0; i < renderer.render_passes.size(); i++)
 	{
 		cleanup_render_pass_manager(renderer, renderer.render_passes[i]);
@@ -2247,6 +2682,7 @@ void resize_swap_chain(Renderer &renderer)
 	VulkanPipeline pipeline_blue = {};
 	VulkanPipeline pipeline_yellow = {};
 	VulkanPipeline pipeline_text = {};
+	VulkanPipeline pipeline_text_batch = {};
 	VulkanPipeline pipeline_volume = {};
 	VulkanPipeline pipeline_darken = {};
 	VulkanPipelineParameters pipeline_parameters = {};
@@ -2313,6 +2749,11 @@ void resize_swap_chain(Renderer &renderer)
 
 	create_pipeline(pipeline_text, pipeline_parameters);
 
+	// Same as text, but with every glyph's position and texture coordinates already in its vertices
+	pipeline_parameters.shaders = { renderer.data.shaders["Resources/vert_text_batch.spv"], renderer.data.shaders["Resources/frag_text.spv"] };
+
+	create_pipeline(pipeline_text_batch, pipeline_parameters);
+
 	pipeline_parameters.attribute_descriptions = attribute_descriptions;
 	pipeline_parameters.binding_descriptions = binding_descriptions;
 	pipeline_parameters.num_textures = 0;
@@ -2332,6 +2773,7 @@ void resize_swap_chain(Renderer &renderer)
 	pipelines.push_back({ "standard_pause", pipeline_pause_screen });
 	pipelines.push_back({ "standard_death", pipeline_death_screen });
 	pipelines.push_back({ "text", pipeline_text });
+	pipelines.push_back({ "text_batch", pipeline_text_batch });
 	pipelines.push_back({ "darken", pipeline_darken });
 
 	// Create pipelines for shadow maps
@@ -2594,6 +3036,16 @@ void resize_swap_chain(Renderer &renderer)
 	mat_text.vertex_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].vertex_buffers[mat_text.pipelines[0]] };
 	mat_text.index_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].index_buffers[mat_text.pipelines[0]] };
 
+	// No model, submit_text_batch supplies the batch's own vertex and index buffers
+	Material mat_text_batch = {};
+	mat_text_batch.models = {};
+	mat_text_batch.pipelines = { "text_batch" };
+	mat_text_batch.textures = { {renderer.data.textures["Resources/ARIAL.png"]} };
+	mat_text_batch.use_lights = LIGHT_USAGE_NONE;
+	mat_text_batch.resources = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].resources[mat_text_batch.pipelines[0]] };
+	mat_text_batch.vertex_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].vertex_buffers[mat_text_batch.pipelines[0]] };
+	mat_text_batch.index_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].index_buffers[mat_text_batch.pipelines[0]] };
+
 	Material mat_volume = {};
 	mat_volume.models = { &renderer.data.models["SQUARE"] };
 	mat_volume.pipelines = { "volume" };
@@ -2619,7 +3071,7 @@ void resize_swap_chain(Renderer &renderer)
 	mat_darken.vertex_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].vertex_buffers[mat_darken.pipelines[0]] };
 	mat_darken.index_buffers = { &renderer.render_passes[RENDER_PASS_INDEX_DRAW].index_buffers[mat_darken.pipelines[0]] };
 
-	renderer.data.materials = { mat_pause_screen, mat_death_screen, mat_red_square, mat_blue_cube, mat_yellow_cube, mat_text, mat_volume, mat_darken };
+	renderer.data.materials = { mat_pause_screen, mat_death_screen, mat_red_square, mat_blue_cube, mat_yellow_cube, mat_text, mat_volume, mat_darken, mat_text_batch };
 
 
 	// Recreate instance for volumetric fog
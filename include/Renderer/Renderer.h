@@ -16,6 +16,7 @@
 #include <Resource.h>
 #include <Command.h>
 
+#include <stdexcept>
 #include <unordered_map>
 
 const uint8_t max_lights = 14;
@@ -37,7 +38,14 @@ enum MaterialIds
 	MATERIAL_YELLOW_CUBE = 4,
 	MATERIAL_TEXT = 5,
 	MATERiAL_VOLUME = 6,
-	MATERIAL_DARKEN = 7
+	MATERIAL_DARKEN = 7,
+	MATERIAL_TEXT_BATCH = 8
+};
+
+enum RendererBackend
+{
+	RENDERER_BACKEND_VULKAN = 0,
+	RENDERER_BACKEND_NULL = 1
 };
 
 enum LightType
@@ -51,10 +59,139 @@ enum LightUsage
 	LIGHT_USAGE_ALL = 1
 };
 
+// Refers to a renderer object by its slot, so reaching it is an array index instead of a string lookup. The slot's
+// generation changes whenever it's freed, so a handle to something that's gone is caught rather than reaching whatever
+// took its slot. Generation 0 is never handed out, so a zeroed handle refers to nothing.
+template <typename T>
+struct RendererHandle
+{
+	uint32_t index;
+	uint32_t generation;
+};
+
+// Dense array of renderer objects reached through handles. Freed slots are reused.
+template <typename T>
+class HandleArray
+{
+public:
+	RendererHandle<T> add(const T &item)
+	{
+		uint32_t index;
+		if (!free_slots.empty())
+		{
+			index = free_slots.back();
+			free_slots.pop_back();
+			items[index] = item;
+		}
+		else
+		{
+			index = static_cast<uint32_t>(items.size());
+			items.push_back(item);
+			generations.push_back(1);
+			alive.push_back(false);
+		}
+
+		alive[index] = true;
+
+		return { index, generations[index] };
+	}
+
+	void remove(RendererHandle<T> handle)
+	{
+		get(handle) = {};
+
+		alive[handle.index] = false;
+		generations[handle.index]++;
+		if (generations[handle.index] == 0)
+		{
+			generations[handle.index] = 1;
+		}
+
+		free_slots.push_back(handle.index);
+	}
+
+	bool contains(RendererHandle<T> handle) const
+	{
+		return handle.index < items.size() && alive[handle.index] && generations[handle.index] == handle.generation;
+	}
+
+	T &get(RendererHandle<T> handle)
+	{
+		if (!contains(handle))
+		{
+			throw std::runtime_error("Tried to use a renderer object that doesn't exist!");
+		}
+
+		return items[handle.index];
+	}
+
+	// Calls function on every object that hasn't been freed
+	template <typename F>
+	void for_each(F function)
+	{
+		for (size_t i = 0; i < items.size(); i++)
+		{
+			if (alive[i])
+			{
+				function(items[i]);
+			}
+		}
+	}
+
+	size_t size() const
+	{
+		return items.size() - free_slots.size();
+	}
+
+private:
+	std::vector<T> items;
+	std::vector<uint32_t> generations;
+	std::vector<bool> alive;
+	std::vector<uint32_t> free_slots;
+};
+
+struct UniformBuffer;
+struct Instance;
+struct TextBatch;
+struct Light;
+
+typedef RendererHandle<UniformBuffer> UniformBufferID;
+typedef RendererHandle<Instance> InstanceID;
+typedef RendererHandle<TextBatch> TextBatchID;
+
+// index is also where the light sits in the shaders' light arrays
+typedef RendererHandle<Light> LightID;
+
 struct Instance
 {
+	std::string name;
 	std::vector<VulkanResource> resources;
 	uint32_t material;
+
+	// Render pass each resource is drawn in
+	std::vector<uint32_t> render_passes;
+};
+
+// One instance resource submitted to a render pass. Instances never change their resources, so a pass given the same
+// entries in the same order as last time records exactly the same commands.
+struct DrawListEntry
+{
+	InstanceID instance;
+	uint32_t resource;
+};
+
+inline bool operator==(const DrawListEntry &entry_1, const DrawListEntry &entry_2)
+{
+	return entry_1.instance.index == entry_2.instance.index && entry_1.instance.generation == entry_2.instance.generation && entry_1.resource == entry_2.resource;
+}
+
+// Render passes whose command buffer was recorded again, ones that were submitted as they were last recorded, and the
+// CPU time spent recording
+struct CommandRecordCounters
+{
+	uint64_t recorded;
+	uint64_t reused;
+	double record_seconds;
 };
 
 struct Material
@@ -140,6 +277,35 @@ struct BoxInternalsUniformBuffer
 	int light_index;
 };
 
+struct TextBatchUniformBuffer
+{
+	glm::mat4 view;
+	glm::mat4 proj;
+};
+
+// Vertex layout of the text batch, matching the textured square the per glyph text pipeline uses
+struct TextVertex
+{
+	alignas(16) glm::vec3 point;
+	alignas(8) glm::vec2 tex_coord;
+};
+
+// Every glyph of a batch is a quad in one vertex buffer per swap chain image, drawn with a single indexed draw
+struct TextBatch
+{
+	std::vector<VulkanBuffer> vertex_buffers;
+	VulkanBuffer index_buffer;
+	UniformBufferID uniform_buffer;
+	InstanceID instance;
+	uint32_t max_glyphs;
+
+	// Glyphs last written to each swap chain image's vertex buffer, so quads left over from a longer frame can be cleared
+	std::vector<uint32_t> written_glyphs;
+
+	// All zero, copied over quads that are no longer in use
+	std::vector<TextVertex> empty_vertices;
+};
+
 struct RenderPassManager
 {
 	VulkanRenderPass pass;
@@ -152,6 +318,11 @@ struct RenderPassManager
 
 	bool mip_map;
 	VulkanMipmapGenerationParameters mip_parameters;
+
+	// What's been submitted to the pass this frame, and what each swap chain image's command buffer was last recorded with
+	std::vector<DrawListEntry> draw_list;
+	std::vector<std::vector<DrawListEntry>> recorded_draw_lists;
+	std::vector<bool> recorded;
 };
 
 struct UniformBuffer
@@ -160,10 +331,21 @@ struct UniformBuffer
 	std::vector<VulkanBuffer> buffers;
 };
 
+// Vulkan objects freed while a frame that may use them could still be on the GPU. They're destroyed once frame has finished.
+struct PendingDestruction
+{
+	uint64_t frame;
+	std::vector<VulkanBuffer> buffers;
+	std::vector<VulkanResource> resources;
+};
+
 struct DataManager
 {
 	std::unordered_map<std::string, VulkanTexture> textures;
-	std::unordered_map<std::string, UniformBuffer> uniform_buffers;
+	HandleArray<UniformBuffer> uniform_buffers;
+
+	// Only used to find buffers by name, never while drawing
+	std::unordered_map<std::string, UniformBufferID> uniform_buffer_names;
 	std::unordered_map<std::string, std::pair<VulkanBuffer, VulkanBuffer>> models;
 	std::unordered_map<std::string, VulkanShader> shaders;
 	std::vector<Material> materials;
@@ -171,6 +353,7 @@ struct DataManager
 
 struct Renderer
 {
+	RendererBackend backend;
 	GLFWwindow *window;
 	VulkanDevice device;
 	VulkanMemoryManager memory_manager;
@@ -185,21 +368,33 @@ struct Renderer
 	std::vector<VkFence> in_flight_fences;
 	std::vector<VkFence> images_in_flight;
 
-	std::unordered_map<std::string, Instance> instances;
+	// Frames submitted so far, the frame each in flight fence was last submitted with and the newest frame known to have finished
+	uint64_t submitted_frames;
+	std::vector<uint64_t> fence_frames;
+	uint64_t finished_frame;
+	std::vector<PendingDestruction> pending_destruction;
 
+	CommandRecordCounters record_counters;
+
+	HandleArray<Instance> instances;
+	std::unordered_map<std::string, InstanceID> instance_names;
+	HandleArray<TextBatch> text_batches;
+
+	// Lights stay in fixed slots so shaders can index them, with a generation per slot for their handles
 	std::vector<Light> lights;
-	std::string light_buffers;
-	std::array<std::string, max_lights> shadow_map_buffers;
-	std::array<std::string, max_lights> shadow_map_fragment_buffers;
+	std::array<uint32_t, max_lights> light_generations;
+	UniformBufferID light_buffers;
+	std::array<UniformBufferID, max_lights> shadow_map_buffers;
 	ShadowMapUniformBuffer shadow_map_uniform;
-	std::string reflection_map_buffer;
-	std::string box_internals_buffer;
-	std::string volume_buffer;
-	std::string volume_instance;
+	UniformBufferID reflection_map_buffer;
+	UniformBufferID box_internals_buffer;
+	UniformBufferID volume_buffer;
+	InstanceID volume_instance;
 };
 
 struct RendererParameters
 {
+	RendererBackend backend;
 	GLFWwindow *window;
 	std::vector<std::string> shader_files;
 	std::vector<std::string> texture_files;
@@ -221,24 +416,43 @@ struct UniformBufferParameters
 	uint32_t range;
 };
 
+// buffer_name is only looked up when buffer is left empty
 struct UniformBufferUpdateParameters
 {
+	UniformBufferID buffer;
 	std::string buffer_name;
 	void *data;
 };
 
 struct InstanceParameters
 {
-	std::vector<std::vector<std::string>> uniform_buffers;
+	std::vector<std::vector<UniformBufferID>> uniform_buffers;
 	uint32_t material;
 	int light_index;
 };
 
+// instance_name is only looked up when instance is left empty
 struct InstanceSubmitParameters
 {
+	InstanceID instance;
 	std::string instance_name;
 };
 
+struct TextBatchParameters
+{
+	uint32_t max_glyphs;
+};
+
+// vertices holds four corners per glyph in world space, in the order bottom left, bottom right, top right, top left
+struct TextBatchUpdateParameters
+{
+	TextBatchID batch;
+	const TextVertex *vertices;
+	uint32_t glyph_count;
+	glm::mat4 view;
+	glm::mat4 proj;
+};
+
 struct LightParameters
 {
 	glm::vec3 location;
@@ -254,13 +468,12 @@ struct LightUpdateParameters
 	glm::vec3 color;
 	float intensity;
 	float max_distance;
-	uint8_t light_index;
+	LightID light;
 };
 
 struct DataManagerParameters
 {
 	std::unordered_map<std::string, VulkanTexture> textures;
-	std::unordered_map<std::string, UniformBuffer> uniform_buffers;
 	std::unordered_map<std::string, std::pair<VulkanBuffer, VulkanBuffer>> models;
 	std::unordered_map<std::string, VulkanShader> shaders;
 	std::vector<Material> materials;
@@ -285,38 +498,64 @@ void draw(Renderer &renderer, DrawParameters &parameters);
 // Updates the uniform buffer for the reflection map
 void update_reflection_map(Renderer &renderer, glm::vec3 location);
 
-// Sets renderer.image_index to the next value
+// Sets renderer.image_index to the next value, once the GPU is done with that image. Write anything for the frame after this.
 void update_image_index(Renderer &renderer, uint32_t draw_frame);
 
 // Cleans up the renderer
 void cleanup_renderer(Renderer &renderer);
 
 // Creates a uniform buffer
+UniformBufferID create_uniform_buffer(Renderer &renderer, UniformBufferParameters &parameters);
+
+// Creates a uniform buffer and returns its name, for code that still refers to buffers by name
 std::string get_uniform_buffer(Renderer &renderer, UniformBufferParameters &parameters);
 
-// Copies data into uniform buffer
+// Finds a uniform buffer by name. This hashes the name, so look it up once and keep the handle.
+UniformBufferID find_uniform_buffer(Renderer &renderer, const std::string &buffer_name);
+
+// Copies data into the current image's uniform buffer. Call between update_image_index and draw.
+// Each object still has its own buffer per image, mapped for every copy; moving these into one
+// persistently mapped buffer bound with dynamic offsets needs the buffer memory and descriptor
+// layout from the Vulkan layer.
 void update_uniform_buffer(Renderer &renderer, UniformBufferUpdateParameters &parameters);
 
 // Cleans up a uniform buffer
-void free_uniform_buffer(Renderer &renderer, std::string buffer);
+void free_uniform_buffer(Renderer &renderer, UniformBufferID buffer);
+void free_uniform_buffer(Renderer &renderer, std::string buffer_name);
 
 // Creates an instance for use with a specific pipeline
-std::string create_instance(Renderer &renderer, InstanceParameters &parameters);
+InstanceID create_instance(Renderer &renderer, InstanceParameters &parameters);
+
+// Finds an instance by name. This hashes the name, so look it up once and keep the handle.
+InstanceID find_instance(Renderer &renderer, const std::string &instance_name);
 
 // Submits an instance for rendering
 void submit_instance(Renderer &renderer, InstanceSubmitParameters &parameters);
 
 // Frees an instance
+void free_instance(Renderer &renderer, InstanceID instance);
 void free_instance(Renderer &renderer, std::string instance_name);
 
+// Creates a batch that draws up to max_glyphs glyphs from the font texture in one draw call
+TextBatchID create_text_batch(Renderer &renderer, TextBatchParameters &parameters);
+
+// Replaces the glyphs the batch draws for the current swap chain image
+void update_text_batch(Renderer &renderer, TextBatchUpdateParameters &parameters);
+
+// Submits every glyph in the batch for rendering
+void submit_text_batch(Renderer &renderer, TextBatchID batch);
+
+// Frees a text batch
+void free_text_batch(Renderer &renderer, TextBatchID batch);
+
 // Creates a light
-uint8_t create_light(Renderer &renderer, LightParameters &parameters);
+LightID create_light(Renderer &renderer, LightParameters &parameters);
 
 // Updates a light
 void update_light(Renderer &renderer, LightUpdateParameters &parameters);
 
 // Frees light
-void free_light(Renderer &renderer, uint8_t light_index);
+void free_light(Renderer &renderer, LightID light);
 
 // Sets up the data manager
 void create_data_manager(DataManager &data_manager, DataManagerParameters &data_manager_parameters);
@@ -327,7 +566,7 @@ void cleanup_data_manager(Renderer &renderer, DataManager &data_manager);
 // Sets up the render pass manager
 void create_render_pass_manager(RenderPassManager &render_pass_manager, RenderPassManagerParameters &render_pass_manager_parameters);
 
-// Cleans up the render pass manager
+// Cleans up the render pass manager. The device must be idle.
 void cleanup_render_pass_manager(Renderer &renderer, RenderPassManager &render_pass_manager);
 
 //  Recreates the necessary components to resize the swap chain
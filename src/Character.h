@@ -1,48 +1,38 @@
 #pragma once
 
-#include "Renderer/Renderer.h"
-#include "GameObject.h"
-#include <glm/mat4x4.hpp>
+#include "EntityRegistry.h"
 #include "Font.h"
 
-struct CharacterUniform
-{
-	glm::mat4 model;
-	glm::mat4 view;
-	glm::mat4 proj;
-	float x;
-	float y;
-	float width;
-	float height;
-};
-
-class Character : public GameObject
+// One glyph of a Text. Owns an entity that the render system draws in its text batch, and lays out the glyph's quad
+// whenever the character or its location changes, so drawing it is just a copy.
+class Character
 {
 public:
-	Character(Renderer *renderer, glm::vec2 location, float scale_factor, Font *font, char character, char previous_character);
-	virtual ~Character();
-	virtual void update(double time);
-	virtual std::vector<Rectangle *> get_collider();
-	virtual void submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height) const;
-	virtual void handle_external_collisions(const Rectangle *collider, const GameObject *other);
-	virtual void pause();
-	virtual void unpause();
+	Character(EntityRegistry *entities, glm::vec2 location, float scale_factor, const Font *font, char character, char previous_character);
+	~Character();
 
 	void update_character(char character, char previous_character);
 	glm::vec2 get_location();
 	void update_location(glm::vec2 new_location);
 	char get_character();
+	void set_visible(bool visible);
+
+	Character(const Character&) = delete;
 
 private:
-	Renderer *renderer;
-	std::string instance;
-	std::string uniform_buffer;
+	// Moves the entity to the glyph's location, nudged by its offset and kerning in the font, and lays out its quad there
+	void place();
+
+	EntityRegistry *entities;
+	EntityID entity;
 
-	glm::mat4 scale;
 	float string_scale_factor;
-	glm::vec3 location;
+	glm::vec2 location;
 
-	Font *font;
+	const Font *font;
 	char character;
 	char previous_character;
-};
\ No newline at end of file
+
+	// x, y, width and height of the character in the font texture, from 0 to 1
+	glm::vec4 atlas_rect;
+};
@@ -1,5 +1,13 @@
 #include "Collider.h"
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define COLLIDER_USE_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLLIDER_USE_SSE
+#endif
+
 Rectangle::Rectangle()
 {
 	position = glm::vec2(0, 0);
@@ -12,6 +20,27 @@ void Rectangle::set_placement(glm::vec2 position, glm::vec2 size)
 	this->size = size;
 }
 
+void RectangleBatch::clear()
+{
+	min_x.clear();
+	min_y.clear();
+	max_x.clear();
+	max_y.clear();
+}
+
+void RectangleBatch::add(const Rectangle *rectangle)
+{
+	min_x.push_back(rectangle->position.x);
+	min_y.push_back(rectangle->position.y);
+	max_x.push_back(rectangle->position.x + rectangle->size.x);
+	max_y.push_back(rectangle->position.y + rectangle->size.y);
+}
+
+size_t RectangleBatch::size() const
+{
+	return min_x.size();
+}
+
 bool check_collision_rect_rect(const Rectangle *collider_1, const Rectangle *collider_2)
 {
 	if (collider_1->position.x < collider_2->position.x + collider_2->size.x &&
@@ -23,4 +52,90 @@ bool check_collision_rect_rect(const Rectangle *collider_1, const Rectangle *col
 	}
 
 	return false;
-}
\ No newline at end of file
+}
+
+// Check the bounds of one rectangle against the rectangles in [begin, end) of a batch
+static size_t check_collision_bounds_batch(float min_x, float min_y, float max_x, float max_y, const RectangleBatch &batch, size_t begin, size_t end, std::vector<uint32_t> &hits)
+{
+	const size_t start_hits = hits.size();
+	size_t i = begin;
+
+#if defined(COLLIDER_USE_AVX)
+	const __m256 collider_min_x = _mm256_set1_ps(min_x);
+	const __m256 collider_min_y = _mm256_set1_ps(min_y);
+	const __m256 collider_max_x = _mm256_set1_ps(max_x);
+	const __m256 collider_max_y = _mm256_set1_ps(max_y);
+
+	for (; i + 8 <= end; i += 8)
+	{
+		__m256 overlap = _mm256_and_ps(_mm256_cmp_ps(collider_min_x, _mm256_loadu_ps(&batch.max_x[i]), _CMP_LT_OQ), _mm256_cmp_ps(_mm256_loadu_ps(&batch.min_x[i]), collider_max_x, _CMP_LT_OQ));
+		overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(collider_min_y, _mm256_loadu_ps(&batch.max_y[i]), _CMP_LT_OQ));
+		overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(_mm256_loadu_ps(&batch.min_y[i]), collider_max_y, _CMP_LT_OQ));
+
+		// One bit per lane that overlaps
+		uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(overlap));
+		for (uint32_t lane = 0; lane < 8; lane++)
+		{
+			if (mask & (1u << lane))
+			{
+				hits.push_back(static_cast<uint32_t>(i + lane));
+			}
+		}
+	}
+#elif defined(COLLIDER_USE_SSE)
+	const __m128 collider_min_x = _mm_set1_ps(min_x);
+	const __m128 collider_min_y = _mm_set1_ps(min_y);
+	const __m128 collider_max_x = _mm_set1_ps(max_x);
+	const __m128 collider_max_y = _mm_set1_ps(max_y);
+
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 overlap = _mm_and_ps(_mm_cmplt_ps(collider_min_x, _mm_loadu_ps(&batch.max_x[i])), _mm_cmplt_ps(_mm_loadu_ps(&batch.min_x[i]), collider_max_x));
+		overlap = _mm_and_ps(overlap, _mm_cmplt_ps(collider_min_y, _mm_loadu_ps(&batch.max_y[i])));
+		overlap = _mm_and_ps(overlap, _mm_cmplt_ps(_mm_loadu_ps(&batch.min_y[i]), collider_max_y));
+
+		// One bit per lane that overlaps
+		uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(overlap));
+		for (uint32_t lane = 0; lane < 4; lane++)
+		{
+			if (mask & (1u << lane))
+			{
+				hits.push_back(static_cast<uint32_t>(i + lane));
+			}
+		}
+	}
+#endif
+
+	// Scalar path for whatever didn't fill a full set of lanes
+	for (; i < end; i++)
+	{
+		if (min_x < batch.max_x[i] && batch.min_x[i] < max_x && min_y < batch.max_y[i] && batch.min_y[i] < max_y)
+		{
+			hits.push_back(static_cast<uint32_t>(i));
+		}
+	}
+
+	return hits.size() - start_hits;
+}
+
+size_t check_collision_rect_batch(const Rectangle *collider, const RectangleBatch &batch, size_t begin, size_t end, std::vector<uint32_t> &hits)
+{
+	return check_collision_bounds_batch(collider->position.x, collider->position.y, collider->position.x + collider->size.x, collider->position.y + collider->size.y, batch, begin, end, hits);
+}
+
+void check_collision_batch_batch(const RectangleBatch &batch_1, const RectangleBatch &batch_2, std::vector<std::pair<uint32_t, uint32_t>> &hits)
+{
+	hits.clear();
+
+	std::vector<uint32_t> row_hits;
+	for (size_t i = 0; i < batch_1.size(); i++)
+	{
+		row_hits.clear();
+		check_collision_bounds_batch(batch_1.min_x[i], batch_1.min_y[i], batch_1.max_x[i], batch_1.max_y[i], batch_2, 0, batch_2.size(), row_hits);
+
+		for (auto hit : row_hits)
+		{
+			hits.push_back({ static_cast<uint32_t>(i), hit });
+		}
+	}
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <stdint.h>
+#include <vector>
+#include <utility>
 #include <glm/glm.hpp>
 
 class Rectangle
@@ -12,5 +14,25 @@ public:
 	glm::vec2 size;
 };
 
+// Rectangles stored as separate arrays of bounds so batches of them can be tested in SIMD lanes
+class RectangleBatch
+{
+public:
+	void clear();
+	void add(const Rectangle *rectangle);
+	size_t size() const;
+
+	std::vector<float> min_x;
+	std::vector<float> min_y;
+	std::vector<float> max_x;
+	std::vector<float> max_y;
+};
+
 // Check collision between two rectangles
-bool check_collision_rect_rect(const Rectangle *collider_1, const Rectangle *collider_2);
\ No newline at end of file
+bool check_collision_rect_rect(const Rectangle *collider_1, const Rectangle *collider_2);
+
+// Check collision between a rectangle and the rectangles in [begin, end) of a batch. Appends the index of every hit to hits and returns the number of hits.
+size_t check_collision_rect_batch(const Rectangle *collider, const RectangleBatch &batch, size_t begin, size_t end, std::vector<uint32_t> &hits);
+
+// Check collision between every rectangle in one batch and every rectangle in another. Fills hits with the index pairs that collide.
+void check_collision_batch_batch(const RectangleBatch &batch_1, const RectangleBatch &batch_2, std::vector<std::pair<uint32_t, uint32_t>> &hits);
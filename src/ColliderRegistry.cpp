@@ -0,0 +1,148 @@
+#include "ColliderRegistry.h"
+
+#include <stdexcept>
+
+uint32_t ColliderRegistry::add_owner()
+{
+	return owner_count++;
+}
+
+ColliderID ColliderRegistry::add(uint32_t owner, uint32_t sub_index, CollisionLayer layer)
+{
+	if (owner >= owner_count)
+	{
+		throw std::runtime_error("Collider added for an owner that was never registered");
+	}
+
+	// Reuse a removed ID if there is one
+	ColliderID id;
+	if (!free_ids.empty())
+	{
+		id = free_ids.back();
+		free_ids.pop_back();
+	}
+	else
+	{
+		id = static_cast<ColliderID>(sparse.size());
+		sparse.push_back(0);
+	}
+
+	sparse[id] = static_cast<uint32_t>(colliders.size());
+
+	colliders.push_back(Rectangle());
+	ids.push_back(id);
+	owners.push_back(owner);
+	layers.push_back(layer);
+	sub_indices.push_back(sub_index);
+	motions.push_back({});
+
+	motion_changes.push_back(id);
+
+	return id;
+}
+
+void ColliderRegistry::remove(ColliderID id)
+{
+	// Move the last collider into the freed slot so the arrays stay packed
+	uint32_t index = sparse[id];
+	uint32_t last = static_cast<uint32_t>(colliders.size() - 1);
+
+	colliders[index] = colliders[last];
+	ids[index] = ids[last];
+	owners[index] = owners[last];
+	layers[index] = layers[last];
+	sub_indices[index] = sub_indices[last];
+	motions[index] = motions[last];
+	sparse[ids[index]] = index;
+
+	colliders.pop_back();
+	ids.pop_back();
+	owners.pop_back();
+	layers.pop_back();
+	sub_indices.pop_back();
+	motions.pop_back();
+
+	free_ids.push_back(id);
+	motion_changes.push_back(id);
+}
+
+Rectangle &ColliderRegistry::get(ColliderID id)
+{
+	return colliders[sparse[id]];
+}
+
+const Rectangle &ColliderRegistry::get(ColliderID id) const
+{
+	return colliders[sparse[id]];
+}
+
+uint32_t ColliderRegistry::get_owner(ColliderID id) const
+{
+	return owners[sparse[id]];
+}
+
+CollisionLayer ColliderRegistry::get_layer(ColliderID id) const
+{
+	return layers[sparse[id]];
+}
+
+uint32_t ColliderRegistry::get_sub_index(ColliderID id) const
+{
+	return sub_indices[sparse[id]];
+}
+
+void ColliderRegistry::set_sub_index(ColliderID id, uint32_t sub_index)
+{
+	sub_indices[sparse[id]] = sub_index;
+}
+
+void ColliderRegistry::set_motion(ColliderID id, const ColliderMotion &motion)
+{
+	motions[sparse[id]] = motion;
+	motion_changes.push_back(id);
+}
+
+const ColliderMotion &ColliderRegistry::get_motion(ColliderID id) const
+{
+	return motions[sparse[id]];
+}
+
+bool ColliderRegistry::contains(ColliderID id) const
+{
+	return id < sparse.size() && sparse[id] < ids.size() && ids[sparse[id]] == id;
+}
+
+const std::vector<ColliderID> &ColliderRegistry::get_motion_changes() const
+{
+	return motion_changes;
+}
+
+void ColliderRegistry::clear_motion_changes()
+{
+	motion_changes.clear();
+}
+
+size_t ColliderRegistry::size() const
+{
+	return colliders.size();
+}
+
+const std::vector<Rectangle> &ColliderRegistry::get_colliders() const
+{
+	return colliders;
+}
+
+const std::vector<ColliderID> &ColliderRegistry::get_ids() const
+{
+	return ids;
+}
+
+const std::vector<uint32_t> &ColliderRegistry::get_owners() const
+{
+	return owners;
+}
+
+const std::vector<CollisionLayer> &ColliderRegistry::get_layers() const
+{
+	return layers;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "Collider.h"
+#include "CollisionLayers.h"
+
+// Stable handle to a collider in a ColliderRegistry. Stays valid until the collider is removed, even as other colliders come and go.
+typedef uint32_t ColliderID;
+
+enum ColliderMotionType
+{
+	// Could be anywhere next tick, so it has to be tested every tick
+	COLLIDER_MOTION_UNKNOWN = 0,
+	// Moves in any direction, never faster than max_speed along either axis
+	COLLIDER_MOTION_BOUNDED = 1,
+	// Moves along direction, and every tick does acceleration += jerk * t, speed += acceleration * t, position += speed * t
+	COLLIDER_MOTION_ACCELERATING = 2
+};
+
+// How a collider moves on from its current placement, so collisions can be predicted rather than tested every tick
+struct ColliderMotion
+{
+	ColliderMotionType type;
+	float max_speed;
+	glm::vec2 direction;
+	float speed;
+	float acceleration;
+	float jerk;
+};
+
+// Owns every collider in the game in one packed array. Objects register their colliders once and refer to them by ID,
+// and each ID maps back to the owner it was added for and the collider's index within that owner.
+class ColliderRegistry
+{
+public:
+	// Registers a new owner for colliders. Colliders with the same owner never collide with each other.
+	uint32_t add_owner();
+
+	ColliderID add(uint32_t owner, uint32_t sub_index, CollisionLayer layer);
+	void remove(ColliderID id);
+
+	Rectangle &get(ColliderID id);
+	const Rectangle &get(ColliderID id) const;
+
+	uint32_t get_owner(ColliderID id) const;
+
+	CollisionLayer get_layer(ColliderID id) const;
+
+	// Index of the collider within its owner, so an object with several colliders can tell which one was hit
+	uint32_t get_sub_index(ColliderID id) const;
+	void set_sub_index(ColliderID id, uint32_t sub_index);
+
+	// Objects set the motion again whenever the collider stops following the last one, like after jumping somewhere new
+	void set_motion(ColliderID id, const ColliderMotion &motion);
+	const ColliderMotion &get_motion(ColliderID id) const;
+
+	bool contains(ColliderID id) const;
+
+	// Every collider added, removed or given new motion since the list was last cleared. May hold the same ID more than once.
+	const std::vector<ColliderID> &get_motion_changes() const;
+	void clear_motion_changes();
+
+	// Packed arrays of every registered collider. The order changes when colliders are removed.
+	size_t size() const;
+	const std::vector<Rectangle> &get_colliders() const;
+	const std::vector<ColliderID> &get_ids() const;
+	const std::vector<uint32_t> &get_owners() const;
+	const std::vector<CollisionLayer> &get_layers() const;
+
+private:
+	// Maps an ID to its place in the packed arrays
+	std::vector<uint32_t> sparse;
+	std::vector<ColliderID> free_ids;
+
+	std::vector<Rectangle> colliders;
+	std::vector<ColliderID> ids;
+	std::vector<uint32_t> owners;
+	std::vector<CollisionLayer> layers;
+	std::vector<uint32_t> sub_indices;
+	std::vector<ColliderMotion> motions;
+
+	std::vector<ColliderID> motion_changes;
+
+	uint32_t owner_count = 0;
+};
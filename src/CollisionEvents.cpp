@@ -0,0 +1,44 @@
+#include "CollisionEvents.h"
+
+#include <algorithm>
+
+void CollisionEventQueue::clear()
+{
+	// Keep the allocation around so a steady state tick doesn't allocate
+	events.clear();
+}
+
+void CollisionEventQueue::push(ColliderID collider_1, ColliderID collider_2)
+{
+	if (collider_2 < collider_1)
+	{
+		std::swap(collider_1, collider_2);
+	}
+
+	events.push_back({ collider_1, collider_2 });
+}
+
+const std::vector<CollisionEvent> &CollisionEventQueue::sort()
+{
+	std::sort(events.begin(), events.end(), [](const CollisionEvent &a, const CollisionEvent &b)
+	{
+		if (a.collider_1 != b.collider_1)
+		{
+			return a.collider_1 < b.collider_1;
+		}
+		return a.collider_2 < b.collider_2;
+	});
+
+	auto last = std::unique(events.begin(), events.end(), [](const CollisionEvent &a, const CollisionEvent &b)
+	{
+		return a.collider_1 == b.collider_1 && a.collider_2 == b.collider_2;
+	});
+	events.erase(last, events.end());
+
+	return events;
+}
+
+const std::vector<CollisionEvent> &CollisionEventQueue::get_events() const
+{
+	return events;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include "ColliderRegistry.h"
+
+// Two colliders found overlapping, lower ID first
+struct CollisionEvent
+{
+	ColliderID collider_1;
+	ColliderID collider_2;
+};
+
+// Every overlap found in a tick, held back until detection has finished so nothing reacts to a collision
+// while other pairs are still being tested. Events are handed out in collider ID order, whatever order detection found them in.
+class CollisionEventQueue
+{
+public:
+	void clear();
+	void push(ColliderID collider_1, ColliderID collider_2);
+
+	// Sorts the events into dispatch order and drops any pair that was found more than once
+	const std::vector<CollisionEvent> &sort();
+
+	const std::vector<CollisionEvent> &get_events() const;
+
+private:
+	std::vector<CollisionEvent> events;
+};
@@ -0,0 +1,31 @@
+#include "CollisionLayers.h"
+
+#include <stdexcept>
+
+CollisionLayerMatrix::CollisionLayerMatrix(bool collide_all)
+{
+	for (auto &mask : masks)
+	{
+		mask = collide_all ? UINT32_MAX : 0;
+	}
+}
+
+void CollisionLayerMatrix::set(CollisionLayer layer_1, CollisionLayer layer_2, bool collide)
+{
+	if (layer_1 >= max_collision_layers || layer_2 >= max_collision_layers)
+	{
+		throw std::runtime_error("Collision layer out of range");
+	}
+
+	// Keep the matrix symmetric so the order of a pair never matters
+	if (collide)
+	{
+		masks[layer_1] |= 1u << layer_2;
+		masks[layer_2] |= 1u << layer_1;
+	}
+	else
+	{
+		masks[layer_1] &= ~(1u << layer_2);
+		masks[layer_2] &= ~(1u << layer_1);
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+
+// What kind of thing a collider is. Each collider sits on one layer, and a CollisionLayerMatrix says which layers collide.
+enum CollisionLayer : uint8_t
+{
+	COLLISION_LAYER_DEFAULT = 0,
+	COLLISION_LAYER_PLAYER = 1,
+	COLLISION_LAYER_ENEMY = 2
+};
+
+const uint32_t max_collision_layers = 32;
+
+// Which pairs of layers collide. Checked before any geometry, so pairs that could never matter cost nothing.
+class CollisionLayerMatrix
+{
+public:
+	// Starts with every layer either colliding with every layer, itself included, or with none
+	CollisionLayerMatrix(bool collide_all = true);
+
+	void set(CollisionLayer layer_1, CollisionLayer layer_2, bool collide);
+
+	bool collides(CollisionLayer layer_1, CollisionLayer layer_2) const
+	{
+		return ((masks[layer_1] >> layer_2) & 1) != 0;
+	}
+
+private:
+	// One bit per layer each layer collides with
+	uint32_t masks[max_collision_layers];
+};
+
+// How many candidate pairs the last collision pass looked at. SpatialHash counts a candidate for every cell the two
+// colliders share, so a pair spanning several cells counts once per cell even though it's only emitted once.
+struct CollisionCounters
+{
+	// Candidates that went through a geometry test
+	uint64_t tested;
+	// Candidates rejected by owner or layer before any geometry test
+	uint64_t culled;
+};
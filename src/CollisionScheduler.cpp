@@ -0,0 +1,399 @@
+#include "CollisionScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Slack added to every prediction to cover rounding in the objects' own float math
+const double prediction_margin = 0.001;
+
+// Furthest ahead a test is ever scheduled. Colliders that can't touch anything before then are checked again then.
+const uint64_t max_prediction_steps = 1 << 16;
+
+// Marks a collider whose motion was set before the scheduler started watching it
+const uint64_t unknown_motion_tick = UINT64_MAX;
+
+// Checks whether two rectangles, each moving in a straight line over the tick to end up at their current placement, overlap at any point
+static bool check_collision_swept(const Rectangle &collider_1, glm::vec2 displacement_1, const Rectangle &collider_2, glm::vec2 displacement_2)
+{
+	// Hold the second collider still at its starting point and move the first relative to it
+	const glm::vec2 relative = displacement_1 - displacement_2;
+	const glm::vec2 start_1 = collider_1.position - displacement_1;
+	const glm::vec2 start_2 = collider_2.position - displacement_2;
+
+	double enter = 0.0;
+	double exit = 1.0;
+
+	for (int axis = 0; axis < 2; axis++)
+	{
+		// Overlap needs start_1 + relative * t < start_2 + size_2 and start_2 < start_1 + size_1 + relative * t
+		const double low = double(start_2[axis]) - (double(start_1[axis]) + collider_1.size[axis]);
+		const double high = double(start_2[axis]) + collider_2.size[axis] - double(start_1[axis]);
+
+		if (relative[axis] == 0.f)
+		{
+			if (low >= 0.0 || high <= 0.0)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		double t_1 = low / relative[axis];
+		double t_2 = high / relative[axis];
+		if (t_1 > t_2)
+		{
+			std::swap(t_1, t_2);
+		}
+
+		enter = std::max(enter, t_1);
+		exit = std::min(exit, t_2);
+	}
+
+	return enter < exit;
+}
+
+// Gap between two intervals along one axis, or 0 if they overlap
+static double axis_gap(float min_1, float max_1, float min_2, float max_2)
+{
+	return std::max(0.0, std::max(double(min_2) - max_1, double(min_1) - max_2));
+}
+
+CollisionScheduler::CollisionScheduler()
+{
+	tick = 0;
+	tick_time = 0.0;
+	rebuild = true;
+	counters = {};
+}
+
+void CollisionScheduler::reset()
+{
+	rebuild = true;
+}
+
+void CollisionScheduler::set_layer_matrix(const CollisionLayerMatrix &matrix)
+{
+	layer_matrix = matrix;
+
+	// Colliders that were never predicted might collide now
+	rebuild = true;
+}
+
+void CollisionScheduler::find_pairs(ColliderRegistry &registry, float tick_time, std::vector<std::pair<ColliderID, ColliderID>> &pairs)
+{
+	pairs.clear();
+	counters = {};
+	tick++;
+	this->tick_time = tick_time;
+
+	bool free_colliders_changed = false;
+
+	// Start over with nothing known about how long anything has been moving
+	if (rebuild)
+	{
+		events = {};
+		free_colliders.clear();
+
+		for (auto id : registry.get_ids())
+		{
+			if (id >= generations.size())
+			{
+				generations.resize(id + 1, 0);
+				motion_ticks.resize(id + 1, unknown_motion_tick);
+			}
+
+			generations[id]++;
+			motion_ticks[id] = unknown_motion_tick;
+
+			if (registry.get_motion(id).type != COLLIDER_MOTION_ACCELERATING)
+			{
+				free_colliders.push_back({ id, registry.get(id), glm::vec2(0.0) });
+			}
+		}
+
+		free_colliders_changed = true;
+		rebuild = false;
+	}
+
+	// Pick up colliders that were added, removed or changed their motion
+	changes = registry.get_motion_changes();
+	registry.clear_motion_changes();
+
+	std::sort(changes.begin(), changes.end());
+	changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+
+	// New colliders always show up here, so this is also where the per ID arrays grow
+	for (auto id : changes)
+	{
+		if (id >= generations.size())
+		{
+			generations.resize(id + 1, 0);
+			motion_ticks.resize(id + 1, unknown_motion_tick);
+		}
+
+		generations[id]++;
+
+		auto free_collider = std::find_if(free_colliders.begin(), free_colliders.end(), [id](const FreeCollider &collider) { return collider.id == id; });
+		if (free_collider != free_colliders.end())
+		{
+			free_colliders.erase(free_collider);
+			free_colliders_changed = true;
+		}
+
+		if (!registry.contains(id))
+		{
+			continue;
+		}
+
+		if (registry.get_motion(id).type == COLLIDER_MOTION_ACCELERATING)
+		{
+			// The motion may have been set before or after this tick's step, so assume the step was taken. Overestimating how long something
+			// has been speeding up only makes predictions earlier.
+			motion_ticks[id] = tick - 1;
+			events.push({ tick, id, generations[id] });
+		}
+		else
+		{
+			free_colliders.push_back({ id, registry.get(id), glm::vec2(0.0) });
+			free_colliders_changed = true;
+		}
+	}
+
+	// Work out how far each free collider moved. Anything that jumped further than its motion allows invalidates every prediction made against it.
+	for (auto &free_collider : free_colliders)
+	{
+		const Rectangle &current = registry.get(free_collider.id);
+		const ColliderMotion &motion = registry.get_motion(free_collider.id);
+
+		free_collider.displacement = current.position - free_collider.previous.position;
+
+		const double max_step = double(motion.max_speed) * tick_time + prediction_margin;
+		if (motion.type == COLLIDER_MOTION_BOUNDED && (std::abs(free_collider.displacement.x) > max_step || std::abs(free_collider.displacement.y) > max_step))
+		{
+			// Don't sweep across the jump
+			free_collider.displacement = glm::vec2(0.0);
+			free_colliders_changed = true;
+		}
+	}
+
+	if (free_colliders_changed)
+	{
+		schedule_all(registry);
+	}
+
+	// Free colliders could be anywhere, so they're tested against each other every tick
+	for (size_t i = 0; i < free_colliders.size(); i++)
+	{
+		for (size_t j = i + 1; j < free_colliders.size(); j++)
+		{
+			const FreeCollider &free_1 = free_colliders[i];
+			const FreeCollider &free_2 = free_colliders[j];
+
+			if (!should_test(registry, free_1.id, free_2.id))
+			{
+				continue;
+			}
+			if (check_collision_swept(registry.get(free_1.id), free_1.displacement, registry.get(free_2.id), free_2.displacement))
+			{
+				pairs.push_back({ free_1.id, free_2.id });
+			}
+		}
+	}
+
+	// Test everything whose time has come, then work out when to test it next
+	while (!events.empty() && events.top().tick <= tick)
+	{
+		Event event = events.top();
+		events.pop();
+
+		if (event.generation != generations[event.id] || !registry.contains(event.id))
+		{
+			continue;
+		}
+
+		for (const auto &free_collider : free_colliders)
+		{
+			if (!should_test(registry, event.id, free_collider.id))
+			{
+				continue;
+			}
+			if (test(registry, event.id, free_collider))
+			{
+				pairs.push_back({ event.id, free_collider.id });
+			}
+		}
+
+		schedule(registry, event.id);
+	}
+
+	for (auto &free_collider : free_colliders)
+	{
+		free_collider.previous = registry.get(free_collider.id);
+	}
+
+	// Drop events that were replaced before they came up once they start to pile up
+	if (events.size() > 4 * registry.size() + 64)
+	{
+		std::vector<Event> live_events;
+		while (!events.empty())
+		{
+			const Event &event = events.top();
+			if (event.generation == generations[event.id] && registry.contains(event.id))
+			{
+				live_events.push_back(event);
+			}
+			events.pop();
+		}
+
+		events = std::priority_queue<Event, std::vector<Event>, EventIsLater>(EventIsLater(), std::move(live_events));
+	}
+}
+
+const CollisionCounters &CollisionScheduler::get_counters() const
+{
+	return counters;
+}
+
+size_t CollisionScheduler::get_queued_events() const
+{
+	return events.size();
+}
+
+void CollisionScheduler::schedule(const ColliderRegistry &registry, ColliderID id)
+{
+	if (free_colliders.empty())
+	{
+		// Nothing can reach it. Adding a free collider schedules everything again.
+		return;
+	}
+
+	const ColliderMotion &motion = registry.get_motion(id);
+	const Rectangle &collider = registry.get(id);
+
+	uint64_t next_step = max_prediction_steps;
+
+	for (const auto &free_collider : free_colliders)
+	{
+		// Nothing to predict for pairs that are never tested
+		if (registry.get_owner(id) == registry.get_owner(free_collider.id) || !layer_matrix.collides(registry.get_layer(id), registry.get_layer(free_collider.id)))
+		{
+			continue;
+		}
+
+		const ColliderMotion &free_motion = registry.get_motion(free_collider.id);
+
+		// Without knowing how either one moves, test again next tick
+		if (free_motion.type != COLLIDER_MOTION_BOUNDED || motion_ticks[id] == unknown_motion_tick)
+		{
+			next_step = 1;
+			break;
+		}
+
+		const Rectangle &other = registry.get(free_collider.id);
+		const double gap_x = axis_gap(collider.position.x, collider.position.x + collider.size.x, other.position.x, other.position.x + other.size.x);
+		const double gap_y = axis_gap(collider.position.y, collider.position.y + collider.size.y, other.position.y, other.position.y + other.size.y);
+
+		// The collider only closes a gap when it moves toward the other one
+		const double closing_x = other.position.x > collider.position.x ? std::max(0.f, motion.direction.x) : std::max(0.f, -motion.direction.x);
+		const double closing_y = other.position.y > collider.position.y ? std::max(0.f, motion.direction.y) : std::max(0.f, -motion.direction.y);
+
+		const uint64_t steps = steps_since_motion(id);
+		const double travelled = travel(motion, steps);
+
+		// Whether the two could be touching after this many more ticks, with both moving straight at each other as fast as they can
+		auto could_touch = [&](uint64_t ahead)
+		{
+			const double free_reach = double(free_motion.max_speed) * tick_time * ahead;
+			const double reach = travel(motion, steps + ahead) - travelled;
+
+			return free_reach + closing_x * reach + prediction_margin >= gap_x && free_reach + closing_y * reach + prediction_margin >= gap_y;
+		};
+
+		// Double the look ahead until they could touch, then narrow it down to the first tick they could
+		uint64_t low = 0;
+		uint64_t high = 1;
+		while (high < next_step && !could_touch(high))
+		{
+			low = high;
+			high *= 2;
+		}
+
+		if (high >= next_step)
+		{
+			continue;
+		}
+
+		while (high - low > 1)
+		{
+			uint64_t middle = low + (high - low) / 2;
+			if (could_touch(middle))
+			{
+				high = middle;
+			}
+			else
+			{
+				low = middle;
+			}
+		}
+
+		next_step = high;
+	}
+
+	events.push({ tick + next_step, id, generations[id] });
+}
+
+void CollisionScheduler::schedule_all(const ColliderRegistry &registry)
+{
+	for (auto id : registry.get_ids())
+	{
+		if (registry.get_motion(id).type == COLLIDER_MOTION_ACCELERATING)
+		{
+			generations[id]++;
+			events.push({ tick, id, generations[id] });
+		}
+	}
+}
+
+bool CollisionScheduler::should_test(const ColliderRegistry &registry, ColliderID id_1, ColliderID id_2)
+{
+	if (registry.get_owner(id_1) == registry.get_owner(id_2) || !layer_matrix.collides(registry.get_layer(id_1), registry.get_layer(id_2)))
+	{
+		counters.culled++;
+		return false;
+	}
+
+	counters.tested++;
+	return true;
+}
+
+bool CollisionScheduler::test(const ColliderRegistry &registry, ColliderID id, const FreeCollider &free_collider) const
+{
+	const ColliderMotion &motion = registry.get_motion(id);
+
+	// How far the collider moved over the last tick, from its closed form path
+	glm::vec2 displacement(0.0);
+	if (motion_ticks[id] != unknown_motion_tick)
+	{
+		const uint64_t steps = steps_since_motion(id);
+		if (steps > 0)
+		{
+			displacement = float(travel(motion, steps) - travel(motion, steps - 1)) * motion.direction;
+		}
+	}
+
+	return check_collision_swept(registry.get(id), displacement, registry.get(free_collider.id), free_collider.displacement);
+}
+
+double CollisionScheduler::travel(const ColliderMotion &motion, uint64_t steps) const
+{
+	// Sums of the per tick updates: speed gains acceleration * t and acceleration gains jerk * t before each step
+	const double n = double(steps);
+	const double t = tick_time;
+
+	return n * t * motion.speed + t * t * motion.acceleration * n * (n + 1.0) / 2.0 + t * t * t * motion.jerk * n * (n + 1.0) * (n + 2.0) / 6.0;
+}
+
+uint64_t CollisionScheduler::steps_since_motion(ColliderID id) const
+{
+	return tick - motion_ticks[id];
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stdint.h>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "ColliderRegistry.h"
+
+// Collision detection that only tests a collider when it could next be touching something. Colliders with
+// accelerating motion follow a path known in closed form, so the earliest tick any freely moving collider could
+// reach them is worked out ahead of time and queued. Nothing is tested for them until that tick comes up. Freely
+// moving colliders are tested against each other every tick. Every test sweeps both colliders across the tick, so
+// fast movers can't pass through each other between ticks.
+class CollisionScheduler
+{
+public:
+	CollisionScheduler();
+
+	// Throws every prediction away, so the next call to find_pairs tests everything
+	void reset();
+
+	// Layers that don't collide are never tested or predicted. Every layer collides with every other by default.
+	void set_layer_matrix(const CollisionLayerMatrix &matrix);
+
+	// Advances one tick of tick_time seconds. Fills pairs with colliders from different owners that touched during it.
+	void find_pairs(ColliderRegistry &registry, float tick_time, std::vector<std::pair<ColliderID, ColliderID>> &pairs);
+
+	// Collider pairs tested and culled by the last call to find_pairs. Colliders whose test hasn't come up yet aren't counted.
+	const CollisionCounters &get_counters() const;
+
+	// Tests waiting in the queue, including ones for colliders that have changed since
+	size_t get_queued_events() const;
+
+private:
+	struct Event
+	{
+		uint64_t tick;
+		ColliderID id;
+		uint32_t generation;
+	};
+
+	struct EventIsLater
+	{
+		bool operator()(const Event &event_1, const Event &event_2) const
+		{
+			return event_1.tick > event_2.tick;
+		}
+	};
+
+	// A collider that moves freely, where it was last tick and how far it moved since
+	struct FreeCollider
+	{
+		ColliderID id;
+		Rectangle previous;
+		glm::vec2 displacement;
+	};
+
+	void schedule(const ColliderRegistry &registry, ColliderID id);
+	void schedule_all(const ColliderRegistry &registry);
+	bool test(const ColliderRegistry &registry, ColliderID id, const FreeCollider &free_collider) const;
+	bool should_test(const ColliderRegistry &registry, ColliderID id_1, ColliderID id_2);
+
+	// Distance an accelerating collider covers in its first steps ticks after its motion was set
+	double travel(const ColliderMotion &motion, uint64_t steps) const;
+	uint64_t steps_since_motion(ColliderID id) const;
+
+	std::priority_queue<Event, std::vector<Event>, EventIsLater> events;
+
+	// Indexed by collider ID. A collider's generation changes whenever its queued events stop being valid.
+	std::vector<uint32_t> generations;
+	std::vector<uint64_t> motion_ticks;
+
+	std::vector<FreeCollider> free_colliders;
+	std::vector<ColliderID> changes;
+
+	uint64_t tick;
+	double tick_time;
+	bool rebuild;
+
+	CollisionLayerMatrix layer_matrix;
+	CollisionCounters counters;
+};
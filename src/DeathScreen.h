@@ -1,43 +1,30 @@
 #pragma once
+#include "Renderer/Renderer.h"
 #include "Text.h"
 
 #include <string>
 
 #include "SoundManager.h"
 
-struct DeathUniform
+class DeathScreen
 {
-	glm::mat4 model;
-	glm::mat4 view;
-	glm::mat4 proj;
-	float time;
-};
+public:
+	DeathScreen(Renderer *renderer, EntityRegistry *entities, const Font *font, double *score_holder);
+	~DeathScreen();
 
-struct DeathDarkenUniform
-{
-	glm::mat4 model;
-	glm::mat4 view;
-	glm::mat4 proj;
-};
+	// Brings the score and high score up to date
+	void update();
 
-class DeathScreen : public GameObject
-{
-public:
-	DeathScreen(Renderer *renderer, Font *font, double *score_holder);
-	virtual ~DeathScreen();
-	virtual void update(double time);
-	virtual std::vector<Rectangle *> get_collider();
-	virtual void submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height) const;
-	virtual void handle_external_collisions(const Rectangle *collider, const GameObject *other);
-	virtual void pause();
-	virtual void unpause();
+	// The screen's entities are only drawn while it's visible
+	void set_visible(bool visible);
 
 	void write_high_score();
 
+	DeathScreen(const DeathScreen&) = delete;
+
 private:
 	Renderer *renderer;
-
-	glm::vec3 location;
+	EntityRegistry *entities;
 
 	Text game_over_text;
 	Text score_text;
@@ -46,13 +33,11 @@ private:
 	Text high_score_number_text;
 	Text enter_restart_text;
 	Text esc_quit_text;
-	std::string square_uniform_buffer;
-	std::string square_instance;
 
-	std::string screen_darken_uniform_buffer;
-	std::string screen_darken_instance;
+	// Animated square behind the text and a quad darkening the arena
+	EntityID square;
+	EntityID screen_darken;
 
 	double *score;
 	double high_score;
-	float run_time;
 };
\ No newline at end of file
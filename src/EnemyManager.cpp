@@ -4,107 +4,259 @@
 #include <algorithm>
 #include "Utilities.h"
 
-EnemyManager::EnemyManager(Renderer *renderer, Font *font, double *score_holder)
-	: score_text_font(font), score_text(renderer, score_text_font, glm::vec2(-0.95f, 0.93f), 1.0f, "SCORE:"), score_number_text(renderer, score_text_font, glm::vec2(-0.5f, 0.93f), 1.0f, "0")
+// Unit vector each EnemyDirection moves along
+const glm::vec2 enemy_direction_vectors[4] = { glm::vec2(0.0, -1.0), glm::vec2(0.0, 1.0), glm::vec2(-1.0, 0.0), glm::vec2(1.0, 0.0) };
+
+EnemyManager::EnemyManager(Renderer *renderer, EntityRegistry *entities, ColliderRegistry *collider_registry, JobSystem *job_system, RandomStream *random, const Font *font, double *score_holder)
+	: pool(renderer, entities, max_enemies, scale_factor), score_text_font(font), score_text(entities, score_text_font, glm::vec2(-0.95f, 0.93f), 1.0f, "SCORE:"), score_number_text(entities, score_text_font, glm::vec2(-0.5f, 0.93f), 1.0f, "0")
 {
 	this->renderer = renderer;
-	type = 1;
-	score = 0;
+	this->entities = entities;
+	this->collider_registry = collider_registry;
+	this->job_system = job_system;
+	this->random = random;
+	collider_owner = collider_registry->add_owner();
 	score = score_holder;
 
-	enemies.push_back(new Enemy(renderer));
-	colliders.push_back(enemies[0]->get_collider()[0]);
+	// Size everything for the most enemies there can be so spawning never allocates
+	directions.reserve(max_enemies);
+	speeds.reserve(max_enemies);
+	accelerations.reserve(max_enemies);
+	states.reserve(max_enemies);
+	colliders.reserve(max_enemies);
+	slots.reserve(max_enemies);
+	redirected.reserve(max_enemies);
+
+	spawn_enemy();
 
 	spawn_time = 0;
 }
 
 EnemyManager::~EnemyManager()
 {
-	for (auto enemy : enemies)
+	// The pool frees the entities and their resources itself
+	for (auto collider : colliders)
 	{
-		delete enemy;
+		collider_registry->remove(collider);
 	}
 }
 
 void EnemyManager::update(double time)
 {
 	spawn_time += time;
-	*score += time * enemies.size();
+	*score += time * states.size();
 
-	auto enemy = enemies.begin();
-	while (enemy != enemies.end())
+	// Remove enemies that finished dying last frame, swapping the last enemy into their slot
+	size_t index = 0;
+	while (index < states.size())
 	{
-		if ((*enemy)->state == ENEMY_DEAD)
+		if (states[index] == ENEMY_DEAD)
 		{
-			// Remove enemy if it is dead
-			delete (*enemy);
-			size_t index = std::distance(enemies.begin(), enemy);
-			enemy = enemies.erase(enemy);
-			colliders.erase(colliders.begin() + index);
+			remove_enemy(index);
 		}
 		else
 		{
-			// Update enemy if it is not dead
-			(*enemy)->update(time);
-			enemy++;
+			index++;
+		}
+	}
+
+	const size_t enemy_count = states.size();
+	const float t = float(time);
+
+	// Remember where everything was for drawing between ticks
+	for (size_t i = 0; i < enemy_count; i++)
+	{
+		Transform &transform = entities->transforms.get(pool.get(slots[i]));
+		transform.previous_location = transform.location;
+	}
+
+	//  If out of bounds, put in new position
+	redirected.clear();
+	for (size_t i = 0; i < enemy_count; i++)
+	{
+		if (states[i] == ENEMY_DEFAULT && glm::dot(entities->transforms.get(pool.get(slots[i])).location, directions[i]) > 1.3f)
+		{
+			pick_direction(i);
+			redirected.push_back(static_cast<uint32_t>(i));
+		}
+	}
+
+	// Move every live enemy. Enemies don't affect each other, so large groups are split over the job system.
+	job_system->parallel_for(0, enemy_count, job_grain, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			const float moving = states[i] == ENEMY_DEFAULT ? 1.f : 0.f;
+
+			accelerations[i] += moving * jerk * t;
+			speeds[i] += moving * t * accelerations[i];
+			entities->transforms.get(pool.get(slots[i])).location += (moving * t * speeds[i]) * directions[i];
+		}
+	});
+
+	// Shrink dying enemies over the death animation, timed by their lifetime
+	for (size_t i = 0; i < enemy_count; i++)
+	{
+		if (states[i] != ENEMY_DEFAULT)
+		{
+			EntityID entity = pool.get(slots[i]);
+			float death_time = entities->lifetimes.get(entity).elapsed;
+
+			entities->transforms.get(entity).scale = glm::vec3(scale_factor * (0.1f + total_death_time - death_time) / (0.1f + total_death_time));
+
+			if (states[i] == ENEMY_DYING && death_time > total_death_time)
+			{
+				// When you're dead, you're dead
+				states[i] = ENEMY_DEAD;
+			}
 		}
 	}
 
-	if (spawn_time > (pow(3.0, (enemies.size()))))
+	// Redirected enemies jumped to a new path, so describe it from where they are now
+	for (auto index : redirected)
 	{
-		if (enemies.size() < max_enemies)
+		update_collider_motion(index);
+	}
+
+	if (spawn_time > (pow(3.0, (states.size()))))
+	{
+		if (states.size() < max_enemies)
 		{
 			// If conditions line up, create enemy
-			enemies.push_back(new Enemy(renderer));
-			colliders.push_back(enemies.back()->get_collider()[0]);
+			spawn_enemy();
 		}
 		spawn_time = 0;
 	}
 
-	score_number_text.update_string(std::to_string(int(*score)));
+	score_number_text.update_number(int(*score));
 }
 
-std::vector<Rectangle *> EnemyManager::get_collider()
+void EnemyManager::handle_player_collision(ColliderID collider)
 {
-	return colliders;
-}
+	// Each collider's sub index is the enemy it belongs to
+	uint32_t index = collider_registry->get_sub_index(collider);
 
-void EnemyManager::submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height) const
-{
-	for (auto &enemy : enemies)
+	if (states[index] == ENEMY_DEFAULT)
 	{
-		enemy->submit_for_rendering(view, proj, width, height);
-	}
+		states[index] = ENEMY_DYING;
+
+		EntityID entity = pool.get(slots[index]);
 
-	score_text.submit_for_rendering(view, proj, width, height);
-	score_number_text.submit_for_rendering(view, proj, width, height);
+		// Dying enemies stay where they were hit
+		entities->colliders.get(entity).follow = false;
+		update_collider_motion(index);
+
+		// Times the death animation
+		Lifetime lifetime = {};
+		lifetime.duration = total_death_time;
+		entities->lifetimes.add(entity, lifetime);
+	}
 }
 
-void EnemyManager::handle_external_collisions(const Rectangle *collider, const GameObject *other)
+void EnemyManager::spawn_enemy()
 {
-	if (other->type == 0)
-	{
-		// Find which enemy collided
-		auto element = std::find(colliders.begin(), colliders.end(), collider);
-		auto index = std::distance(colliders.begin(), element);
+	size_t index = states.size();
 
-		// Tell enemy to handle collision
-		enemies[index]->handle_external_collisions(collider, other);
-	}
+	directions.push_back(glm::vec2(0.0));
+	speeds.push_back(0.f);
+	accelerations.push_back(0.f);
+	states.push_back(ENEMY_DEFAULT);
+	colliders.push_back(collider_registry->add(collider_owner, static_cast<uint32_t>(index), COLLISION_LAYER_ENEMY));
+
+	// Render and audio resources come from the pool rather than being created here
+	slots.push_back(pool.acquire(glm::vec2(0.0)));
+
+	EntityID entity = pool.get(slots[index]);
+	entities->transforms.get(entity).scale = glm::vec3(scale_factor);
+
+	pick_direction(index);
+
+	// The collider system keeps the collider on the enemy from here on
+	ColliderHandle collider = {};
+	collider.collider = colliders[index];
+	collider.size = .90f * glm::vec2(scale_factor, scale_factor);
+	collider.follow = true;
+	entities->colliders.add(entity, collider);
+
+	const glm::vec2 location = entities->transforms.get(entity).location;
+
+	collider_registry->get(colliders[index]).set_placement(location - collider.size / 2.f, collider.size);
+	update_collider_motion(index);
 }
 
-void EnemyManager::pause()
+void EnemyManager::remove_enemy(size_t index)
 {
-	for (auto &enemy : enemies)
+	EntityID entity = pool.get(slots[index]);
+	entities->colliders.remove(entity);
+	entities->lifetimes.remove(entity);
+
+	pool.release(slots[index]);
+	collider_registry->remove(colliders[index]);
+
+	// Move the last enemy into the freed slot so the arrays stay packed
+	size_t last = states.size() - 1;
+
+	// The last enemy's collider is already gone from the registry when it's the one removed
+	if (index != last)
 	{
-		enemy->pause();
+		directions[index] = directions[last];
+		speeds[index] = speeds[last];
+		accelerations[index] = accelerations[last];
+		states[index] = states[last];
+		colliders[index] = colliders[last];
+		collider_registry->set_sub_index(colliders[index], static_cast<uint32_t>(index));
+		slots[index] = slots[last];
 	}
+
+	directions.pop_back();
+	speeds.pop_back();
+	accelerations.pop_back();
+	states.pop_back();
+	colliders.pop_back();
+	slots.pop_back();
 }
 
-void EnemyManager::unpause()
+void EnemyManager::pick_direction(size_t index)
 {
-	for (auto &enemy : enemies)
+	// Reset acceleration
+	accelerations[index] = start_acceleration;
+
+	// Generate direction
+	EnemyDirection direction = static_cast<EnemyDirection>(random->range(0, 3));
+	directions[index] = enemy_direction_vectors[direction];
+
+	// Find new location on the axis not determined by direction, starting on the opposite side of the arena
+	float rand_location = float(1.75 * (random->range(0, 100) / 100.0 - 0.5));
+	glm::vec2 cross_axis = glm::vec2(std::abs(directions[index].y), std::abs(directions[index].x));
+
+	Transform &transform = entities->transforms.get(pool.get(slots[index]));
+	transform.location = -1.2f * directions[index] + rand_location * cross_axis;
+
+	// Jump straight to the new location instead of sliding across the arena
+	transform.previous_location = transform.location;
+
+	// Reset speed
+	speeds[index] = 0;
+}
+
+void EnemyManager::update_collider_motion(size_t index)
+{
+	ColliderMotion motion = {};
+
+	// Dying enemies no longer move, so there's no path left to sweep
+	if (states[index] != ENEMY_DEFAULT)
 	{
-		enemy->unpause();
+		motion.type = COLLIDER_MOTION_BOUNDED;
+		motion.max_speed = 0.f;
+		collider_registry->set_motion(colliders[index], motion);
+		return;
 	}
+
+	motion.type = COLLIDER_MOTION_ACCELERATING;
+	motion.direction = directions[index];
+	motion.speed = speeds[index];
+	motion.acceleration = accelerations[index];
+	motion.jerk = jerk;
+
+	collider_registry->set_motion(colliders[index], motion);
 }
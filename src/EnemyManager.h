@@ -1,34 +1,84 @@
 #pragma once
-#include "GameObject.h"
-#include "Enemy.h"
-#include <stack>
+#include "Renderer/Renderer.h"
+#include "EntityRegistry.h"
+#include "SoundManager.h"
+#include "EnemyPool.h"
+#include "JobSystem.h"
+#include "Random.h"
 #include "Font.h"
 #include "Text.h"
 
-class EnemyManager : public GameObject
+enum EnemyState
+{
+	ENEMY_DEFAULT = 0,
+	ENEMY_DYING = 1,
+	ENEMY_DEAD = 2
+};
+
+enum EnemyDirection
+{
+	ENEMY_MOVING_DOWN = 0,
+	ENEMY_MOVING_UP = 1,
+	ENEMY_MOVING_LEFT = 2,
+	ENEMY_MOVING_RIGHT = 3
+};
+
+class EnemyManager
 {
 public:
-	EnemyManager(Renderer *renderer, Font *font, double *score_holder);
-	virtual ~EnemyManager();
+	EnemyManager(Renderer *renderer, EntityRegistry *entities, ColliderRegistry *collider_registry, JobSystem *job_system, RandomStream *random, const Font *font, double *score_holder);
+	~EnemyManager();
+
+	void update(double time);
+
+	// Kills the enemy the collider belongs to
+	void handle_player_collision(ColliderID collider);
 
-	virtual void update(double time);
-	virtual std::vector<Rectangle *> get_collider();
-	virtual void submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height) const;
-	virtual void handle_external_collisions(const Rectangle *collider, const GameObject *other);
-	virtual void pause();
-	virtual void unpause();
+	EnemyManager(const EnemyManager&) = delete;
 
 private:
+	void spawn_enemy();
+	void remove_enemy(size_t index);
+	void pick_direction(size_t index);
+	void update_collider_motion(size_t index);
+
 	Renderer *renderer;
-	std::vector<Enemy *> enemies;
-	std::vector<Rectangle *> colliders;
+	EntityRegistry *entities;
+	ColliderRegistry *collider_registry;
+	uint32_t collider_owner;
+	JobSystem *job_system;
+	RandomStream *random;
+
+	// Simulation state for each enemy, stored as parallel arrays so the update loop runs over contiguous memory.
+	// Where each enemy is lives in its entity's transform.
+	std::vector<glm::vec2> directions;
+	std::vector<float> speeds;
+	std::vector<float> accelerations;
+	std::vector<EnemyState> states;
+	std::vector<ColliderID> colliders;
+
+	// Pool slot holding each enemy's entity, which carries its transform along with its render, light and audio resources
+	std::vector<uint32_t> slots;
+
+	// Enemies sent off in a new direction this tick
+	std::vector<uint32_t> redirected;
 
 	const uint32_t max_enemies = 13;
+	const float start_acceleration = 1.2f;
+	const float jerk = 0.75f;
+	const float total_death_time = 0.2f;
+	const float scale_factor = 0.12f;
+
+	// Fewest enemies worth splitting into a separate job. A game never has more than max_enemies, so in play update always
+	// moves them on the calling thread. Only the "jobs" benchmark runs enemy movement at sizes that get split.
+	const size_t job_grain = 1024;
 	double *score;
 
 	double spawn_time;
 
-	Font *score_text_font;
+	EnemyPool pool;
+
+	const Font *score_text_font;
 	Text score_text;
 	Text score_number_text;
-};
\ No newline at end of file
+};
@@ -0,0 +1,146 @@
+#include "EnemyPool.h"
+#include "Systems.h"
+
+#include <stdexcept>
+
+EnemyPool::EnemyPool(Renderer *renderer, EntityRegistry *entities, uint32_t capacity, float scale_factor)
+	: sound_manager(&SoundManager::get_instance())
+{
+	this->renderer = renderer;
+	this->entities = entities;
+
+	slots.resize(capacity);
+
+	for (uint32_t i = 0; i < capacity; i++)
+	{
+		Transform transform = {};
+		transform.depth = -(0.5f - (scale_factor / 2.f) - 0.001f);
+		transform.scale = glm::vec3(scale_factor);
+
+		UniformBufferParameters uniform_parameters = {};
+		uniform_parameters.size = sizeof(MeshUniform);
+
+		RenderHandle render = {};
+		render.kind = RENDER_KIND_MESH;
+		render.visible = false;
+		render.uniform_buffer = create_uniform_buffer(*renderer, uniform_parameters);
+
+		// Lights stay allocated for the whole game, so unused slots are kept dark instead of freed
+		LightParameters light_parameters = {};
+		light_parameters.color = glm::vec3(0.84, 0.67, 0.23);
+		light_parameters.intensity = 0.f;
+		light_parameters.location = glm::vec3(0.0, 0.0, -1.0);
+		light_parameters.max_distance = 1.0f;
+		light_parameters.type = LIGHT_POINT;
+
+		LightHandle light = {};
+		light.light = create_light(*renderer, light_parameters);
+		light.color = glm::vec3(0.84, 0.67, 0.23);
+		light.intensity = 0.8f;
+		light.max_distance = 2.5f;
+		light.enabled = false;
+
+		InstanceParameters instance_parameters = {};
+		instance_parameters.material = MATERIAL_YELLOW_CUBE;
+		instance_parameters.uniform_buffers = { { render.uniform_buffer }, { render.uniform_buffer } };
+
+		render.instance = create_instance(*renderer, instance_parameters);
+
+		AudioHandle audio = {};
+		audio.sounds[0] = sound_manager->register_sound(SOUND_TYPE_ENEMY);
+		audio.sound_count = 1;
+		audio.positional = true;
+
+		sound_manager->update_sound_loop(audio.sounds[0], true);
+		sound_manager->update_sound_gain(audio.sounds[0], 1.2f);
+		sound_manager->update_sound_max_distance(audio.sounds[0], 0.04f);
+
+		slots[i] = entities->create();
+		entities->transforms.add(slots[i], transform);
+		entities->renders.add(slots[i], render);
+		entities->lights.add(slots[i], light);
+		entities->sounds.add(slots[i], audio);
+	}
+
+	// Hand out the lowest slots first
+	for (uint32_t i = capacity; i > 0; i--)
+	{
+		free_slots.push_back(i - 1);
+	}
+}
+
+EnemyPool::~EnemyPool()
+{
+	for (auto entity : slots)
+	{
+		size_t sound = entities->sounds.get(entity).sounds[0];
+		sound_manager->stop_sound(sound);
+
+		if (renderer->device.device != VK_NULL_HANDLE)
+		{
+			const RenderHandle &render = entities->renders.get(entity);
+			free_uniform_buffer(*renderer, render.uniform_buffer);
+			free_instance(*renderer, render.instance);
+			free_light(*renderer, entities->lights.get(entity).light);
+		}
+
+		sound_manager->delete_sound(sound);
+
+		entities->destroy(entity);
+	}
+}
+
+uint32_t EnemyPool::acquire(glm::vec2 location)
+{
+	if (free_slots.empty())
+	{
+		throw std::runtime_error("Tried to spawn more enemies than the pool holds!");
+	}
+
+	uint32_t slot = free_slots.back();
+	free_slots.pop_back();
+
+	EntityID entity = slots[slot];
+
+	Transform &transform = entities->transforms.get(entity);
+	transform.location = location;
+	transform.previous_location = location;
+
+	entities->renders.get(entity).visible = true;
+	entities->lights.get(entity).enabled = true;
+
+	size_t sound = entities->sounds.get(entity).sounds[0];
+	sound_manager->update_sound_position(sound, location.x, location.y, 0.0);
+	sound_manager->update_sound_velocity(sound, 0.0, 0.0, 0.0);
+	sound_manager->play_sound(sound);
+
+	return slot;
+}
+
+void EnemyPool::release(uint32_t slot)
+{
+	EntityID entity = slots[slot];
+
+	sound_manager->stop_sound(entities->sounds.get(entity).sounds[0]);
+
+	entities->renders.get(entity).visible = false;
+
+	// Turn the light off so it doesn't keep glowing where the enemy died
+	LightHandle &light = entities->lights.get(entity);
+	light.enabled = false;
+
+	LightUpdateParameters light_update_parameters = {};
+	light_update_parameters.light = light.light;
+	light_update_parameters.color = light.color;
+	light_update_parameters.intensity = 0.f;
+	light_update_parameters.max_distance = 1.0f;
+	light_update_parameters.location = glm::vec3(0.0, 0.0, -1.0);
+	update_light(*renderer, light_update_parameters);
+
+	free_slots.push_back(slot);
+}
+
+EntityID EnemyPool::get(uint32_t slot) const
+{
+	return slots[slot];
+}
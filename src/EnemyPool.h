@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Renderer/Renderer.h"
+#include "SoundManager.h"
+#include "EntityRegistry.h"
+
+// Creates an entity for every enemy up front, with its render, light and audio resources, and hands them out as enemies spawn,
+// so spawning and killing enemies never creates or frees Vulkan or OpenAL objects. Entities of free slots are hidden and silent.
+class EnemyPool
+{
+public:
+	EnemyPool(Renderer *renderer, EntityRegistry *entities, uint32_t capacity, float scale_factor);
+	~EnemyPool();
+
+	// Takes a free slot, shows it at location and starts its sound
+	uint32_t acquire(glm::vec2 location);
+
+	// Silences, hides and darkens a slot and returns it to the pool
+	void release(uint32_t slot);
+
+	EntityID get(uint32_t slot) const;
+
+	EnemyPool(const EnemyPool&) = delete;
+
+private:
+	Renderer *renderer;
+	EntityRegistry *entities;
+	SoundManager *sound_manager;
+
+	std::vector<EntityID> slots;
+	std::vector<uint32_t> free_slots;
+};
@@ -0,0 +1,52 @@
+#include "EntityRegistry.h"
+
+EntityID EntityRegistry::create()
+{
+	// Reuse a destroyed ID if there is one
+	EntityID entity;
+	if (!free_ids.empty())
+	{
+		entity = free_ids.back();
+		free_ids.pop_back();
+	}
+	else
+	{
+		entity = static_cast<EntityID>(alive.size());
+		alive.push_back(false);
+	}
+
+	alive[entity] = true;
+	count++;
+
+	return entity;
+}
+
+void EntityRegistry::destroy(EntityID entity)
+{
+	if (!contains(entity))
+	{
+		throw std::runtime_error("Tried to destroy an entity that doesn't exist!");
+	}
+
+	transforms.remove(entity);
+	colliders.remove(entity);
+	renders.remove(entity);
+	glyph_quads.remove(entity);
+	lights.remove(entity);
+	sounds.remove(entity);
+	lifetimes.remove(entity);
+
+	alive[entity] = false;
+	free_ids.push_back(entity);
+	count--;
+}
+
+bool EntityRegistry::contains(EntityID entity) const
+{
+	return entity < alive.size() && alive[entity];
+}
+
+size_t EntityRegistry::size() const
+{
+	return count;
+}
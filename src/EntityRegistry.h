@@ -0,0 +1,214 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Renderer/Renderer.h"
+#include "ColliderRegistry.h"
+
+// Stable handle to an entity in an EntityRegistry. IDs of destroyed entities are handed out again.
+typedef uint32_t EntityID;
+
+// Where an entity is, where it was at the start of the last tick and how big it's drawn
+struct Transform
+{
+	glm::vec2 location;
+	glm::vec2 previous_location;
+	float depth;
+	glm::vec3 scale;
+};
+
+// Collider that's placed centred on the entity's location with the given size every tick, unless it's stopped following
+struct ColliderHandle
+{
+	ColliderID collider;
+	glm::vec2 size;
+	bool follow;
+};
+
+enum RenderKind
+{
+	// Lit model placed in the arena, with the entity's light index in its uniform
+	RENDER_KIND_MESH = 0,
+	// One character of text, drawn from the entity's GlyphQuad
+	RENDER_KIND_GLYPH = 1,
+	// Flat screen overlay, with the entity's lifetime in its uniform
+	RENDER_KIND_OVERLAY = 2
+};
+
+struct RenderHandle
+{
+	// Glyphs leave these empty, the render system draws them all together in its text batch
+	InstanceID instance;
+	UniformBufferID uniform_buffer;
+	RenderKind kind;
+	bool visible;
+};
+
+// A glyph's corners, already placed in the world and in the font texture, so drawing it is just a copy.
+// Glyphs don't move between ticks, so whoever moves the glyph lays this out again.
+struct GlyphQuad
+{
+	TextVertex vertices[4];
+};
+
+struct LightHandle
+{
+	LightID light;
+	glm::vec3 color;
+	float intensity;
+	float max_distance;
+
+	// Where the light sits relative to the entity
+	glm::vec2 offset;
+	bool enabled;
+};
+
+// Most sounds one entity can own
+const uint32_t max_entity_sounds = 2;
+
+struct AudioHandle
+{
+	size_t sounds[max_entity_sounds];
+	uint32_t sound_count;
+
+	// Positional sounds follow the entity around. The rest play relative to the listener.
+	bool positional;
+
+	// Sounds that were playing when the game was paused
+	bool resume[max_entity_sounds];
+};
+
+// Time since the component was added. Owners decide what happens once it passes duration.
+struct Lifetime
+{
+	float elapsed;
+	float duration;
+
+	// Keeps counting while the game is paused or over, for things like menu animations
+	bool runs_while_paused;
+};
+
+// Packed array of one kind of component, indexed by entity through a sparse array so systems can walk
+// every component of a kind without touching entities that don't have one
+template <typename T>
+class ComponentArray
+{
+public:
+	T &add(EntityID entity, const T &component)
+	{
+		if (entity >= sparse.size())
+		{
+			sparse.resize(entity + 1, invalid_index);
+		}
+
+		if (sparse[entity] != invalid_index)
+		{
+			throw std::runtime_error("Entity already has this component!");
+		}
+
+		sparse[entity] = static_cast<uint32_t>(components.size());
+		components.push_back(component);
+		entities.push_back(entity);
+
+		return components.back();
+	}
+
+	void remove(EntityID entity)
+	{
+		if (!has(entity))
+		{
+			return;
+		}
+
+		// Move the last component into the freed slot so the array stays packed
+		uint32_t index = sparse[entity];
+		uint32_t last = static_cast<uint32_t>(components.size() - 1);
+
+		components[index] = std::move(components[last]);
+		entities[index] = entities[last];
+		sparse[entities[index]] = index;
+		sparse[entity] = invalid_index;
+
+		components.pop_back();
+		entities.pop_back();
+	}
+
+	bool has(EntityID entity) const
+	{
+		return entity < sparse.size() && sparse[entity] != invalid_index;
+	}
+
+	T &get(EntityID entity)
+	{
+		return components[sparse[entity]];
+	}
+
+	const T &get(EntityID entity) const
+	{
+		return components[sparse[entity]];
+	}
+
+	void reserve(size_t count)
+	{
+		components.reserve(count);
+		entities.reserve(count);
+	}
+
+	size_t size() const
+	{
+		return components.size();
+	}
+
+	// Every component of this kind and the entity each belongs to, in the same order. The order changes when components are removed.
+	std::vector<T> &get_components()
+	{
+		return components;
+	}
+
+	const std::vector<T> &get_components() const
+	{
+		return components;
+	}
+
+	const std::vector<EntityID> &get_entities() const
+	{
+		return entities;
+	}
+
+private:
+	static constexpr uint32_t invalid_index = UINT32_MAX;
+
+	std::vector<uint32_t> sparse;
+	std::vector<EntityID> entities;
+	std::vector<T> components;
+};
+
+// Holds every entity in a game as a set of optional components. Entities have no behaviour of their own,
+// the systems in Systems.h run over whichever components they need and skip everything else.
+class EntityRegistry
+{
+public:
+	EntityID create();
+
+	// Removes the entity and every component it has. Resources the components refer to belong to whoever made them.
+	void destroy(EntityID entity);
+
+	bool contains(EntityID entity) const;
+	size_t size() const;
+
+	ComponentArray<Transform> transforms;
+	ComponentArray<ColliderHandle> colliders;
+	ComponentArray<RenderHandle> renders;
+	ComponentArray<GlyphQuad> glyph_quads;
+	ComponentArray<LightHandle> lights;
+	ComponentArray<AudioHandle> sounds;
+	ComponentArray<Lifetime> lifetimes;
+
+private:
+	std::vector<bool> alive;
+	std::vector<EntityID> free_ids;
+	size_t count = 0;
+};
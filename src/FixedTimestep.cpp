@@ -0,0 +1,55 @@
+#include "FixedTimestep.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+FixedTimestep::FixedTimestep(double tick_rate, uint32_t max_ticks_per_frame)
+{
+	if (tick_rate <= 0.0 || max_ticks_per_frame == 0)
+	{
+		throw std::runtime_error("Fixed timestep needs a positive tick rate and at least one tick per frame");
+	}
+
+	tick_time = 1.0 / tick_rate;
+	this->max_ticks_per_frame = max_ticks_per_frame;
+	accumulator = 0.0;
+	dropped_time = 0.0;
+}
+
+uint32_t FixedTimestep::advance(double frame_time)
+{
+	// If a frame takes longer than the ticks it would need can be run, running them all would make the next frame
+	// take even longer. Drop the excess instead so the game slows down rather than locking up.
+	const double max_frame_time = max_ticks_per_frame * tick_time;
+	if (frame_time > max_frame_time)
+	{
+		dropped_time += frame_time - max_frame_time;
+		frame_time = max_frame_time;
+	}
+
+	accumulator += frame_time;
+
+	uint32_t ticks = 0;
+	while (accumulator >= tick_time && ticks < max_ticks_per_frame)
+	{
+		accumulator -= tick_time;
+		ticks++;
+	}
+
+	return ticks;
+}
+
+double FixedTimestep::get_tick_time() const
+{
+	return tick_time;
+}
+
+float FixedTimestep::get_interpolation() const
+{
+	return static_cast<float>(std::min(1.0, accumulator / tick_time));
+}
+
+double FixedTimestep::get_dropped_time() const
+{
+	return dropped_time;
+}
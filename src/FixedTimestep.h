@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+// Turns variable frame times into a whole number of fixed length simulation ticks. Time that doesn't fill a tick
+// carries over to the next frame, and the fraction of a tick left over is used to interpolate between the last two ticks.
+class FixedTimestep
+{
+public:
+	FixedTimestep(double tick_rate, uint32_t max_ticks_per_frame);
+
+	// Adds a frame's worth of time and returns how many ticks to run for it
+	uint32_t advance(double frame_time);
+
+	double get_tick_time() const;
+
+	// How far the frame is between the last tick and the next, from 0 to 1
+	float get_interpolation() const;
+
+	// Total game time thrown away because a frame took longer than max_ticks_per_frame ticks
+	double get_dropped_time() const;
+
+private:
+	double tick_time;
+	uint32_t max_ticks_per_frame;
+
+	double accumulator;
+	double dropped_time;
+};
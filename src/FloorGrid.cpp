@@ -0,0 +1,82 @@
+#include "FloorGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+FloorGrid::FloorGrid(uint32_t grid_size, float half_width)
+{
+	if (grid_size == 0)
+	{
+		throw std::runtime_error("Floor grid must have at least one tile");
+	}
+
+	this->grid_size = grid_size;
+	this->half_width = half_width;
+	tile_width = (2.f * half_width) / grid_size;
+	inverse_tile_width = 1.f / tile_width;
+
+	active_tiles = std::vector<float>(grid_size * grid_size, 0.f);
+}
+
+bool FloorGrid::get_covered_tiles(const Rectangle *collider, TileRange &range) const
+{
+	// Rectangle bounds in units of tiles from the edge of the floor
+	float min_x = (collider->position.x + half_width) * inverse_tile_width;
+	float min_y = (collider->position.y + half_width) * inverse_tile_width;
+	float max_x = (collider->position.x + collider->size.x + half_width) * inverse_tile_width;
+	float max_y = (collider->position.y + collider->size.y + half_width) * inverse_tile_width;
+
+	// Tiles are half open, so a rectangle ending exactly on a tile edge doesn't cover the next tile
+	if (max_x <= 0.f || max_y <= 0.f || min_x >= grid_size || min_y >= grid_size)
+	{
+		return false;
+	}
+
+	range.min_x = static_cast<uint32_t>(std::max(0.f, std::floor(min_x)));
+	range.min_y = static_cast<uint32_t>(std::max(0.f, std::floor(min_y)));
+	range.max_x = static_cast<uint32_t>(std::min(float(grid_size), std::ceil(max_x))) - 1;
+	range.max_y = static_cast<uint32_t>(std::min(float(grid_size), std::ceil(max_y))) - 1;
+
+	return true;
+}
+
+void FloorGrid::mark(const Rectangle *collider)
+{
+	TileRange range;
+	if (!get_covered_tiles(collider, range))
+	{
+		return;
+	}
+
+	for (uint32_t x = range.min_x; x <= range.max_x; x++)
+	{
+		for (uint32_t y = range.min_y; y <= range.max_y; y++)
+		{
+			active_tiles[x * grid_size + y] = 1.f;
+		}
+	}
+}
+
+void FloorGrid::fade(float time)
+{
+	for (auto &tile : active_tiles)
+	{
+		tile = std::max(0.0f, tile - time);
+	}
+}
+
+uint32_t FloorGrid::get_grid_size() const
+{
+	return grid_size;
+}
+
+float FloorGrid::get_tile_width() const
+{
+	return tile_width;
+}
+
+const std::vector<float> &FloorGrid::get_active_tiles() const
+{
+	return active_tiles;
+}
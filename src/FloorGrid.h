@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "Collider.h"
+
+// Inclusive range of floor tiles along each axis
+struct TileRange
+{
+	uint32_t min_x;
+	uint32_t min_y;
+	uint32_t max_x;
+	uint32_t max_y;
+};
+
+// Square grid of floor tiles centred on the origin. Tiles light up when something moves over them and fade back out over time.
+class FloorGrid
+{
+public:
+	FloorGrid(uint32_t grid_size, float half_width);
+
+	// Finds the tiles a rectangle overlaps. Returns false if it doesn't overlap the floor at all.
+	bool get_covered_tiles(const Rectangle *collider, TileRange &range) const;
+
+	// Lights every tile the rectangle overlaps
+	void mark(const Rectangle *collider);
+
+	// Dims every tile by time, down to zero
+	void fade(float time);
+
+	uint32_t get_grid_size() const;
+	float get_tile_width() const;
+
+	// Tile brightness, indexed by x * grid_size + y
+	const std::vector<float> &get_active_tiles() const;
+
+private:
+	uint32_t grid_size;
+	float half_width;
+	float tile_width;
+	float inverse_tile_width;
+
+	std::vector<float> active_tiles;
+};
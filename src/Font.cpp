@@ -1,7 +1,25 @@
 #include "Font.h"
 
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
-#include <string>
+#include <random>
+
+// Cache layout: magic, version, the size and write time of the .fnt it was made from, the texture size, then chars and kerning exactly as they're held in a Font
+const char font_cache_magic[4] = { 'D', 'B', 'F', 'N' };
+const uint32_t font_cache_version = 1;
+
+template <typename T>
+static void write_value(std::ofstream &file, const T &value)
+{
+	file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+static void read_value(std::ifstream &file, T &value)
+{
+	file.read(reinterpret_cast<char *>(&value), sizeof(T));
+}
 
 Font::Font(FontType type)
 {
@@ -11,86 +29,224 @@ Font::Font(FontType type)
 		total_width = 512;
 		total_height = 512;
 
-		// Open .fnt file (Note: I modified the file by adding spaces to make the next part easier)
-		std::ifstream file_stream;
-		file_stream.open("Resources/ARIAL.fnt");
-		std::string line;
+		const std::string file_name = "Resources/ARIAL.fnt";
+		const std::string cache_name = file_name + ".cache";
+
+		// The cache is only trusted if it was made from a .fnt of the same size and write time
+		std::error_code error;
+		uint64_t source_size = std::filesystem::file_size(file_name, error);
+		int64_t source_time = error ? 0 : int64_t(std::filesystem::last_write_time(file_name, error).time_since_epoch().count());
 
-		while (!file_stream.eof())
+		if (error || !load_cache(cache_name, source_size, source_time))
 		{
-			// Read line of file
-			std::getline(file_stream, line);
+			// Anything not in the file is left empty
+			std::fill(std::begin(chars), std::end(chars), CharacterDetails{});
+			std::fill(std::begin(kerning), std::end(kerning), int16_t(0));
 
-			// If the line is describing a character
-			if (line.substr(0, 4) == "char" && line.substr(0, 5) != "chars")
+			parse(file_name);
+
+			// Not being able to write the cache just means parsing again next time
+			if (!error)
 			{
-				std::stringstream ss;
-				ss << line;
-
-				// Read which character it is
-				int char_index = 0;
-				get_next_int(&ss, char_index);
-
-				// Read the character's x-value
-				int char_x = 0;
-				get_next_int(&ss, char_x);
-
-				// Read the character's y-value
-				int char_y = 0;
-				get_next_int(&ss, char_y);
-
-				// Read the character's width
-				int char_width = 0;
-				get_next_int(&ss, char_width);
-
-				// Read the character's height
-				int char_height = 0;
-				get_next_int(&ss, char_height);
-
-				// Read the amount to offset the character in the x-direction
-				int char_x_off = 0;
-				get_next_int(&ss, char_x_off);
-
-				// Read the amount to offset the character in the y-direction
-				int char_y_off = 0;
-				get_next_int(&ss, char_y_off);
-
-				// Read how much to advance after writing the character
-				int advance = 0;
-				get_next_int(&ss, advance);
-
-				// Fill out struct
-				chars[char_index].x = char_x;
-				chars[char_index].y = char_y;
-				chars[char_index].x_offset = char_x_off;
-				chars[char_index].y_offset = char_y_off;
-				chars[char_index].width = char_width;
-				chars[char_index].height = char_height;
-				chars[char_index].advance = advance;
+				save_cache(cache_name, source_size, source_time);
 			}
-			else if (line.substr(0, 7) == "kerning" && line.substr(0, 8) != "kernings")
+		}
+	}
+}
+
+const Font &Font::get(FontType type)
+{
+	// Only Arial so far
+	static const Font arial(FONT_ARIAL);
+	return arial;
+}
+
+int Font::get_kerning(char previous_character, char character) const
+{
+	uint8_t previous_index = static_cast<uint8_t>(previous_character);
+	uint8_t index = static_cast<uint8_t>(character);
+
+	if (previous_index >= font_char_count || index >= font_char_count)
+	{
+		return 0;
+	}
+
+	return kerning[previous_index * font_char_count + index];
+}
+
+void Font::parse(const std::string &file_name)
+{
+	// Open .fnt file (Note: I modified the file by adding spaces to make the next part easier)
+	std::ifstream file_stream;
+	file_stream.open(file_name);
+	std::string line;
+
+	while (!file_stream.eof())
+	{
+		// Read line of file
+		std::getline(file_stream, line);
+
+		// If the line is describing a character
+		if (line.substr(0, 4) == "char" && line.substr(0, 5) != "chars")
+		{
+			std::stringstream ss;
+			ss << line;
+
+			// Read which character it is
+			int char_index = 0;
+			get_next_int(&ss, char_index);
+
+			// Read the character's x-value
+			int char_x = 0;
+			get_next_int(&ss, char_x);
+
+			// Read the character's y-value
+			int char_y = 0;
+			get_next_int(&ss, char_y);
+
+			// Read the character's width
+			int char_width = 0;
+			get_next_int(&ss, char_width);
+
+			// Read the character's height
+			int char_height = 0;
+			get_next_int(&ss, char_height);
+
+			// Read the amount to offset the character in the x-direction
+			int char_x_off = 0;
+			get_next_int(&ss, char_x_off);
+
+			// Read the amount to offset the character in the y-direction
+			int char_y_off = 0;
+			get_next_int(&ss, char_y_off);
+
+			// Read how much to advance after writing the character
+			int advance = 0;
+			get_next_int(&ss, advance);
+
+			if (char_index < 0 || char_index >= int(font_char_count))
 			{
-				std::stringstream ss;
-				ss << line;
+				continue;
+			}
 
-				// Read the first character this kerning information is describing
-				int char_index_1 = 0;
-				get_next_int(&ss, char_index_1);
+			// Fill out struct
+			chars[char_index].x = char_x;
+			chars[char_index].y = char_y;
+			chars[char_index].x_offset = char_x_off;
+			chars[char_index].y_offset = char_y_off;
+			chars[char_index].width = char_width;
+			chars[char_index].height = char_height;
+			chars[char_index].advance = advance;
+		}
+		else if (line.substr(0, 7) == "kerning" && line.substr(0, 8) != "kernings")
+		{
+			std::stringstream ss;
+			ss << line;
+
+			// Read the first character this kerning information is describing
+			int char_index_1 = 0;
+			get_next_int(&ss, char_index_1);
 
-				// Read the second character this kerning information is describing
-				int char_index_2 = 0;
-				get_next_int(&ss, char_index_2);
+			// Read the second character this kerning information is describing
+			int char_index_2 = 0;
+			get_next_int(&ss, char_index_2);
 
-				// Read how much to modify the second value along the x-axis
-				int amount = 0;
-				get_next_int(&ss, amount);
+			// Read how much to modify the second value along the x-axis
+			int amount = 0;
+			get_next_int(&ss, amount);
 
-				chars[char_index_2].kerning_details[char_index_1] = amount;
+			if (char_index_1 < 0 || char_index_1 >= int(font_char_count) || char_index_2 < 0 || char_index_2 >= int(font_char_count))
+			{
+				continue;
 			}
+
+			kerning[char_index_1 * font_char_count + char_index_2] = static_cast<int16_t>(amount);
 		}
+	}
+
+	file_stream.close();
+}
+
+bool Font::load_cache(const std::string &file_name, uint64_t source_size, int64_t source_time)
+{
+	std::ifstream file(file_name, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	char magic[4];
+	uint32_t version;
+	uint64_t cached_size;
+	int64_t cached_time;
+	uint32_t cached_width;
+	uint32_t cached_height;
+
+	file.read(magic, sizeof(magic));
+	read_value(file, version);
+	read_value(file, cached_size);
+	read_value(file, cached_time);
+	read_value(file, cached_width);
+	read_value(file, cached_height);
+
+	if (!file || std::string(magic, 4) != std::string(font_cache_magic, 4) || version != font_cache_version || cached_size != source_size || cached_time != source_time ||
+		cached_width != total_width || cached_height != total_height)
+	{
+		return false;
+	}
+
+	// A truncated cache is parsed over from scratch
+	read_value(file, chars);
+	read_value(file, kerning);
 
-		file_stream.close();
+	return bool(file);
+}
+
+bool Font::save_cache(const std::string &file_name, uint64_t source_size, int64_t source_time) const
+{
+	// Written under a name of its own and renamed into place once it's complete, so anything reading the cache
+	// at the same time, another process included, sees either the old one or the new one in full
+	const std::string temp_name = file_name + "." + std::to_string(std::random_device()()) + ".tmp";
+
+	if (!write_cache(temp_name, source_size, source_time))
+	{
+		std::error_code error;
+		std::filesystem::remove(temp_name, error);
+		return false;
 	}
+
+	std::error_code error;
+	std::filesystem::rename(temp_name, file_name, error);
+
+	if (error)
+	{
+		std::filesystem::remove(temp_name, error);
+		return false;
+	}
+
+	return true;
+}
+
+bool Font::write_cache(const std::string &file_name, uint64_t source_size, int64_t source_time) const
+{
+	std::ofstream file(file_name, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file.write(font_cache_magic, sizeof(font_cache_magic));
+	write_value(file, font_cache_version);
+	write_value(file, source_size);
+	write_value(file, source_time);
+	write_value(file, total_width);
+	write_value(file, total_height);
+	write_value(file, chars);
+	write_value(file, kerning);
+
+	return bool(file);
 }
 
 void get_next_int(std::stringstream *stream, int &value)
@@ -107,4 +263,4 @@ void get_next_int(std::stringstream *stream, int &value)
 			break;
 		}
 	}
-}
\ No newline at end of file
+}
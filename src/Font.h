@@ -1,7 +1,8 @@
 #pragma once
 
-#include <map>
+#include <stdint.h>
 #include <sstream>
+#include <string>
 
 struct CharacterDetails
 {
@@ -12,8 +13,6 @@ struct CharacterDetails
 	uint32_t width;
 	uint32_t height;
 	uint32_t advance;
-
-	std::map<char, int> kerning_details;
 };
 
 enum FontType
@@ -21,14 +20,36 @@ enum FontType
 	FONT_ARIAL = 0
 };
 
+// Characters a font has details for, indexed by their ASCII code
+const uint32_t font_char_count = 127;
+
+// Loaded from a binary cache next to the .fnt file when there's an up to date one. Otherwise the .fnt is parsed and the cache is written for next time.
 class Font
 {
 public:
 	Font(FontType type);
-	CharacterDetails chars[127];
+
+	// The font of this type every game shares, loaded the first time it's asked for. Safe to call from any thread.
+	static const Font &get(FontType type);
+
+	// How far to move character along x when it follows previous_character
+	int get_kerning(char previous_character, char character) const;
+
+	CharacterDetails chars[font_char_count];
 	uint32_t total_width;
 	uint32_t total_height;
+
+private:
+	void parse(const std::string &file_name);
+
+	// Both return false if the cache can't be used, or written
+	bool load_cache(const std::string &file_name, uint64_t source_size, int64_t source_time);
+	bool save_cache(const std::string &file_name, uint64_t source_size, int64_t source_time) const;
+	bool write_cache(const std::string &file_name, uint64_t source_size, int64_t source_time) const;
+
+	// Every pair of characters, indexed by previous character * font_char_count + character. Most pairs are 0.
+	int16_t kerning[font_char_count * font_char_count];
 };
 
 // Extracts an int from a string. Used in font loading
-void get_next_int(std::stringstream *stream, int &value);
\ No newline at end of file
+void get_next_int(std::stringstream *stream, int &value);
@@ -3,18 +3,37 @@
 #include "EnemyManager.h"
 #include "Text.h"
 
+#include <stdexcept>
 #include "glm/gtc/matrix_transform.hpp"
 
-Input GameManager::input = {false, false, false, false, false};
+Input GameManager::keyboard_input = {false, false, false, false, false};
 
-GameManager::GameManager(Renderer *renderer, uint32_t width, uint32_t height)
+GameManager::GameManager(Renderer *renderer, uint32_t width, uint32_t height, uint64_t seed, JobSystem *job_system, uint32_t floor_grid_size)
+	: owned_job_system(job_system == nullptr ? std::make_unique<JobSystem>(1) : nullptr), job_system(job_system == nullptr ? owned_job_system.get() : job_system), render_system(renderer, this->job_system), random(seed), layer_matrix(false), broadphase(broadphaseCellWidth), floor_grid(floor_grid_size, halfWidth)
 {
+	if (floor_grid_size > maxFloorGridSize)
+	{
+		throw std::runtime_error("Floor grid is larger than the floor shader supports");
+	}
+
 	this->renderer = renderer;
 	game_should_end = false;
+
 	start_new_game = false;
+	collision_mode = COLLISION_MODE_DISCRETE;
+	collision_counters = {};
+
+	// Only the player and enemies care about touching each other
+	layer_matrix.set(COLLISION_LAYER_PLAYER, COLLISION_LAYER_ENEMY, true);
+	broadphase.set_layer_matrix(layer_matrix);
+	collision_scheduler.set_layer_matrix(layer_matrix);
+	tick_time = 0.0;
 	score = 0.0;
 	user_quit = false;
 
+	// Keys held from the last game have to be let go before they do anything
+	esc_released = false;
+
 	input.down = false;
 	input.enter = false;
 	input.esc = false;
@@ -30,25 +49,20 @@ GameManager::GameManager(Renderer *renderer, uint32_t width, uint32_t height)
 	view_height = 2.5f * tan(glm::radians(45.0f / 2.0f));
 	view_width = view_height;
 
-	font = new Font(FONT_ARIAL);
+	font = &Font::get(FONT_ARIAL);
 
-	objects.push_back(new Player(renderer, &input, &game_should_end));
-	objects.push_back(new EnemyManager(renderer, font, &score));
+	player = new Player(renderer, &entities, &collider_registry, &input, &game_should_end);
+	enemy_manager = new EnemyManager(renderer, &entities, &collider_registry, this->job_system, &random, font, &score);
 
 	transform = glm::scale(glm::translate(glm::mat4(1), glm::vec3(0.0, 0.0, -0.5)), glm::vec3(2.071, 2.071, 1.0));
 
 	UniformBufferParameters uniform_parameters = {};
 	uniform_parameters.size = sizeof(FloorVertUniform);
 	
-	vert_uniform_buffer = get_uniform_buffer(*renderer, uniform_parameters);
-
-	for (uint32_t i = 0; i < 196; i++)
-	{
-		active_tiles[i] = 0.f;
-	}
+	vert_uniform_buffer = create_uniform_buffer(*renderer, uniform_parameters);
 
 	uniform_parameters.size = sizeof(FloorFragUniform);
-	frag_uniform_buffer = get_uniform_buffer(*renderer, uniform_parameters);
+	frag_uniform_buffer = create_uniform_buffer(*renderer, uniform_parameters);
 
 	InstanceParameters instance_parameters = {};
 	instance_parameters.material = MATERIAL_RED_SQUARE;
@@ -58,8 +72,8 @@ GameManager::GameManager(Renderer *renderer, uint32_t width, uint32_t height)
 
 	state = GAME_STATE_DEFAULT;
 
-	pause_screen = new PauseScreen(renderer, font);
-	death_screen = new DeathScreen(renderer, font, &score);
+	pause_screen = new PauseScreen(renderer, &entities, font);
+	death_screen = new DeathScreen(renderer, &entities, font, &score);
 
 	sound_manager = &SoundManager::get_instance();
 
@@ -77,9 +91,10 @@ GameManager::GameManager(Renderer *renderer, uint32_t width, uint32_t height)
 
 GameManager::~GameManager()
 {
-	delete font;
 	delete pause_screen;
 	delete death_screen;
+	delete enemy_manager;
+	delete player;
 
 	sound_manager->stop_sound(music_sound);
 	sound_manager->delete_sound(music_sound);
@@ -90,11 +105,6 @@ GameManager::~GameManager()
 		free_uniform_buffer(*renderer, frag_uniform_buffer);
 		free_instance(*renderer, instance);
 	}
-
-	for (auto &object : objects)
-	{
-		delete object;
-	}
 }
 
 void GameManager::handle_input(GLFWwindow *window, int key, int scancode, int action, int mods)
@@ -103,74 +113,82 @@ void GameManager::handle_input(GLFWwindow *window, int key, int scancode, int ac
 	{
 		if (key == GLFW_KEY_UP)
 		{
-			input.up = true;
+			keyboard_input.up = true;
 		}
 		else if (key == GLFW_KEY_DOWN)
 		{
-			input.down = true;
+			keyboard_input.down = true;
 		}
 		else if (key == GLFW_KEY_LEFT)
 		{
-			input.left = true;
+			keyboard_input.left = true;
 		}
 		else if (key == GLFW_KEY_RIGHT)
 		{
-			input.right = true;
+			keyboard_input.right = true;
 		}
 		else if (key == GLFW_KEY_W)
 		{
-			input.w = true;
+			keyboard_input.w = true;
 		}
 		else if (key == GLFW_KEY_ESCAPE)
 		{
-			input.esc = true;
+			keyboard_input.esc = true;
 		}
 		else if (key == GLFW_KEY_ENTER)
 		{
-			input.enter = true;
+			keyboard_input.enter = true;
 		}
 	}
 	else if (action == GLFW_RELEASE)
 	{
 		if (key == GLFW_KEY_UP)
 		{
-			input.up = false;
+			keyboard_input.up = false;
 		}
 		else if (key == GLFW_KEY_DOWN)
 		{
-			input.down = false;
+			keyboard_input.down = false;
 		}
 		else if (key == GLFW_KEY_LEFT)
 		{
-			input.left = false;
+			keyboard_input.left = false;
 		}
 		else if (key == GLFW_KEY_RIGHT)
 		{
-			input.right = false;
+			keyboard_input.right = false;
 		}
 		else if (key == GLFW_KEY_W)
 		{
-			input.w = false;
+			keyboard_input.w = false;
 		}
 		else if (key == GLFW_KEY_ESCAPE)
 		{
-			input.esc = false;
+			keyboard_input.esc = false;
 		}
 		else if (key == GLFW_KEY_ENTER)
 		{
-			input.enter = false;
+			keyboard_input.enter = false;
 		}
 	}
 }
 
 void GameManager::update(double time, uint32_t width, uint32_t height)
 {
+	tick_time = time;
+
 	// If the player dies, play gameover music update high score
 	if (game_should_end && state != GAME_STATE_OVER)
 	{
 		state = GAME_STATE_OVER;
 		sound_manager->update_sound_gain(music_sound, 0.1f);
-		death_screen->write_high_score();
+		death_screen->set_visible(true);
+
+		// Headless runs shouldn't overwrite the player's save data
+		if (renderer->backend != RENDERER_BACKEND_NULL)
+		{
+			death_screen->write_high_score();
+		}
 	}
 
 	// Handle pausing/playing/quitting
@@ -185,22 +203,18 @@ void GameManager::update(double time, uint32_t width, uint32_t height)
 			state = GAME_STATE_DEFAULT;
 			sound_manager->update_sound_gain(music_sound, 0.3f);
 			play_menu_sound();
+			pause_screen->set_visible(false);
 
-			for (auto &object : objects)
-			{
-				object->unpause();
-			}
+			resume_sounds(entities, *sound_manager);
 		}
 		else if (state == GAME_STATE_DEFAULT)
 		{
 			state = GAME_STATE_PAUSED;
 			sound_manager->update_sound_gain(music_sound, 0.1f);
 			play_menu_sound();
+			pause_screen->set_visible(true);
 
-			for (auto &object : objects)
-			{
-				object->pause();
-			}
+			pause_sounds(entities, *sound_manager);
 		}
 		else if (state == GAME_STATE_OVER)
 		{
@@ -218,94 +232,96 @@ void GameManager::update(double time, uint32_t width, uint32_t height)
 	}
 
 
+	// Animations that play over menus keep going while the game is stopped
+	update_lifetimes(entities, float(time), state != GAME_STATE_DEFAULT);
+
 	if (state == GAME_STATE_DEFAULT)
 	{
-		// For every object
-		for (uint32_t i = 0; i < objects.size(); i++)
+		// Light the tiles under every collider
+		for (const auto &collider : collider_registry.get_colliders())
 		{
-			// For every collider the object contains
-			for (auto& collider : objects[i]->get_collider())
-			{
-				// For every floor tile
-				for (uint32_t k = 0; k < 14; k++)
-				{
-					for (uint32_t f = 0; f < 14; f++)
-					{
-						// Check if they collide
-						Rectangle floor_rect;
-						floor_rect.set_placement(glm::vec2(-halfWidth + k * tileWidth, -halfWidth + f * tileWidth), glm::vec2(tileWidth, tileWidth));
-						if (check_collision_rect_rect(collider, &floor_rect))
-						{
-							active_tiles[k * 14 + f] = 1.f;
-						}
-					}
-				}
-			}
+			floor_grid.mark(&collider);
 		}
 
-		// For every floor tile
-		for (uint32_t k = 0; k < 14; k++)
-		{
-			for (uint32_t f = 0; f < 14; f++)
-			{
-				// Subtract the time
-				active_tiles[k * 14 + f] = std::max(0.0f, active_tiles[k * 14 + f] - float(time));
-			}
-		}
+		// Dim every floor tile
+		floor_grid.fade(float(time));
 
-		for (auto object : objects)
-		{
-			object->update(time);
-		}
+		player->update(time);
+		enemy_manager->update(time);
+
+		// Bring colliders and sounds along with whatever moved
+		place_colliders(entities, collider_registry);
+		place_sounds(entities, *sound_manager, time);
 	}
 
-	death_screen->update(time);
-	pause_screen->update(time);
+	death_screen->update();
 }
 
 void GameManager::resolve_collisions()
 {
-	// Check for collision
+	// Check for collision. Detection only queues what it finds, and nothing reacts until every pair has been tested.
 	if (state == GAME_STATE_DEFAULT)
 	{
-		for (uint32_t i = 0; i < objects.size(); i++)
+		collision_events.clear();
+
+		if (collision_mode == COLLISION_MODE_SCHEDULED)
 		{
-			for (uint32_t j = i + 1; j < objects.size(); j++)
+			collision_scheduler.find_pairs(collider_registry, float(tick_time), scheduled_pairs);
+			collision_counters = collision_scheduler.get_counters();
+
+			for (auto pair : scheduled_pairs)
 			{
-				for (auto &collider_1 : objects[i]->get_collider())
-				{
-					for (auto &collider_2 : objects[j]->get_collider())
-					{
-						if (check_collision_rect_rect(collider_1, collider_2))
-						{
-							objects[i]->handle_external_collisions(collider_1, objects[j]);
-							objects[j]->handle_external_collisions(collider_2, objects[i]);
-						}
-					}
-				}
+				collision_events.push(pair.first, pair.second);
 			}
+
+			dispatch_collisions();
+			return;
 		}
+
+		// Only the scheduler needs to know about motion
+		collider_registry.clear_motion_changes();
+
+		// Bucket every collider into the broadphase grid
+		broadphase.clear();
+
+		const auto &colliders = collider_registry.get_colliders();
+		const auto &owners = collider_registry.get_owners();
+		const auto &ids = collider_registry.get_ids();
+		const auto &layers = collider_registry.get_layers();
+
+		for (size_t i = 0; i < colliders.size(); i++)
+		{
+			broadphase.insert(&colliders[i], owners[i], layers[i]);
+		}
+
+		// Only colliders that share a cell and are on layers that collide are tested
+		broadphase.find_pairs(colliding_pairs, job_system);
+		collision_counters = broadphase.get_counters();
+
+		// Colliders were inserted in registry order, so entry indices are also indices into the packed arrays
+		for (auto pair : colliding_pairs)
+		{
+			collision_events.push(ids[pair.first], ids[pair.second]);
+		}
+
+		dispatch_collisions();
 	}
 }
 
-void GameManager::submit_for_rendering(uint32_t width, uint32_t height)
+void GameManager::submit_for_rendering(uint32_t width, uint32_t height, float interpolation)
 {
-	proj = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 10.0f);
-	proj[1][1] *= -1;
-
-	if (state == GAME_STATE_PAUSED)
+	// Nothing moves while paused or after the game ends, so draw exactly where things are
+	if (state != GAME_STATE_DEFAULT)
 	{
-		pause_screen->submit_for_rendering(view, proj, view_width, view_height);
-	}
-	else if (state == GAME_STATE_OVER)
-	{
-		death_screen->submit_for_rendering(view, proj, view_width, view_height);
+		interpolation = 1.f;
 	}
 
-	for (auto object : objects)
-	{
-		object->submit_for_rendering(view, proj, view_width, view_height);
-	}
+	proj = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 10.0f);
+	proj[1][1] *= -1;
+
+	// The screens are only visible in the state they belong to, so everything can be drawn in one go
+	player->submit_for_rendering(interpolation);
+	render_system.submit(entities, view, proj, view_width, view_height, interpolation);
 
 	FloorVertUniform buffer_data = {};
 	buffer_data.model = transform;
@@ -314,24 +330,27 @@ void GameManager::submit_for_rendering(uint32_t width, uint32_t height)
 	buffer_data.light_index = -1;
 
 	UniformBufferUpdateParameters update_parameters = {};
-	update_parameters.buffer_name = vert_uniform_buffer;
+	update_parameters.buffer = vert_uniform_buffer;
 	update_parameters.data = &buffer_data;
 
 	update_uniform_buffer(*renderer, update_parameters);
 
 	FloorFragUniform frag_buffer_data = {};
-	for (uint32_t i = 0; i < 196; i++)
+	frag_buffer_data.grid_size = floor_grid.get_grid_size();
+
+	const auto &active_tiles = floor_grid.get_active_tiles();
+	for (uint32_t i = 0; i < active_tiles.size(); i++)
 	{
-		frag_buffer_data.active_tiles[i].value = active_tiles[i];
+		frag_buffer_data.active_tiles[i / 4][i % 4] = active_tiles[i];
 	}
 
-	update_parameters.buffer_name = frag_uniform_buffer;
+	update_parameters.buffer = frag_uniform_buffer;
 	update_parameters.data = &frag_buffer_data;
 
 	update_uniform_buffer(*renderer, update_parameters);
 
 	InstanceSubmitParameters submit_parameters = {};
-	submit_parameters.instance_name = instance;
+	submit_parameters.instance = instance;
 
 	submit_instance(*renderer, submit_parameters);
 }
@@ -341,11 +360,79 @@ bool GameManager::game_has_ended() const
 	return start_new_game;
 }
 
+bool GameManager::game_is_over() const
+{
+	return state == GAME_STATE_OVER;
+}
+
 bool GameManager::should_quit() const
 {
 	return user_quit;
 }
 
+double GameManager::get_score() const
+{
+	return score;
+}
+
+const Input &GameManager::get_input() const
+{
+	return input;
+}
+
+void GameManager::set_input(const Input &new_input)
+{
+	input = new_input;
+}
+
+const Input &GameManager::get_keyboard_input()
+{
+	return keyboard_input;
+}
+
+void GameManager::set_collision_mode(CollisionMode mode)
+{
+	collision_mode = mode;
+
+	// Predictions made before don't account for anything that happened in the meantime
+	collision_scheduler.reset();
+}
+
+const CollisionScheduler &GameManager::get_collision_scheduler() const
+{
+	return collision_scheduler;
+}
+
+const CollisionCounters &GameManager::get_collision_counters() const
+{
+	return collision_counters;
+}
+
+void GameManager::dispatch_collisions()
+{
+	// Sorted by collider ID, so every game reacts to the same collisions in the same order however they were found
+	for (const auto &event : collision_events.sort())
+	{
+		handle_collision(event.collider_1, event.collider_2);
+	}
+}
+
+void GameManager::handle_collision(ColliderID collider_1, ColliderID collider_2)
+{
+	// Keep the player as the first of the pair
+	if (collider_registry.get_layer(collider_1) > collider_registry.get_layer(collider_2))
+	{
+		std::swap(collider_1, collider_2);
+	}
+
+	// The layer matrix only lets the player and enemies touch, but check in case it changes
+	if (collider_registry.get_layer(collider_1) == COLLISION_LAYER_PLAYER && collider_registry.get_layer(collider_2) == COLLISION_LAYER_ENEMY)
+	{
+		player->handle_enemy_collision();
+		enemy_manager->handle_player_collision(collider_2);
+	}
+}
+
 void GameManager::play_menu_sound()
 {
 	sound_manager->update_sound_relative(menu_sound, true);
@@ -1,9 +1,16 @@
 #pragma once
 
-#include "GameObject.h"
 #include "Renderer/Renderer.h"
+#include "EntityRegistry.h"
+#include "Systems.h"
 #include "PauseScreen.h"
 #include "DeathScreen.h"
+#include "SpatialHash.h"
+#include "CollisionScheduler.h"
+#include "CollisionEvents.h"
+#include "FloorGrid.h"
+#include "JobSystem.h"
+#include "Random.h"
 
 enum GameState
 {
@@ -12,6 +19,14 @@ enum GameState
 	GAME_STATE_OVER = 2
 };
 
+enum CollisionMode
+{
+	// Test everything every tick through the broadphase grid
+	COLLISION_MODE_DISCRETE = 0,
+	// Only test colliders when their motion says they could be touching
+	COLLISION_MODE_SCHEDULED = 1
+};
+
 struct Input
 {
 	bool up, down, left, right;
@@ -28,51 +43,100 @@ struct FloorVertUniform
 	int light_index;
 };
 
+// Number of floor tiles along each side unless another size is asked for
+const uint32_t defaultFloorGridSize = 14;
+
+// Largest floor grid the floor shaders have room for
+const uint32_t maxFloorGridSize = 32;
+
 struct FloorFragUniform
 {
-	AlignedFloat active_tiles[196];
-};
+	int grid_size;
+	int padding[3];
 
-// Width of floor tile
-const float tileWidth = (5.f * tan(glm::radians(45.f / 2.f))) / 14;
+	// Four tiles packed into each vec4
+	glm::vec4 active_tiles[(maxFloorGridSize * maxFloorGridSize) / 4];
+};
 
 // Width of half the floor 
 const float halfWidth = (2.5f * tan(glm::radians(45.f / 2.f)));
 
+// Width of a cell in the collision broadphase grid
+const float broadphaseCellWidth = 0.25f;
+
+class Player;
+class EnemyManager;
+
 class GameManager
 {
 public:
-	GameManager(Renderer *renderer, uint32_t width, uint32_t height);
+	// seed decides every random choice the game makes. Without a job system the game runs on the calling thread.
+	GameManager(Renderer *renderer, uint32_t width, uint32_t height, uint64_t seed, JobSystem *job_system = nullptr, uint32_t floor_grid_size = defaultFloorGridSize);
 	~GameManager();
 
 	static void handle_input(GLFWwindow *window, int key, int scancode, int action, int mods);
 	void update(double time, uint32_t width, uint32_t height);
 	void resolve_collisions();
-	void submit_for_rendering(uint32_t width, uint32_t height);
+	// interpolation is how far between the last two ticks to draw moving objects, from 0 to 1
+	void submit_for_rendering(uint32_t width, uint32_t height, float interpolation);
 	bool game_has_ended() const;
+	bool game_is_over() const;
 	bool should_quit() const;
+	double get_score() const;
+
+	void set_collision_mode(CollisionMode mode);
+	const CollisionScheduler &get_collision_scheduler() const;
+
+	// Candidate collider pairs tested and culled by the last resolve_collisions. In discrete mode these are per shared cell, see CollisionCounters.
+	const CollisionCounters &get_collision_counters() const;
+
+	// Input the next update will see. Each game has its own, so games can run side by side.
+	const Input &get_input() const;
+	void set_input(const Input &new_input);
+
+	// Keys currently held down, as tracked by handle_input
+	static const Input &get_keyboard_input();
 
 	GameManager(const GameManager&) = delete;
 
 private:
 	void play_menu_sound();
-
-	std::vector<GameObject *> objects;
+	void dispatch_collisions();
+	void handle_collision(ColliderID collider_1, ColliderID collider_2);
+
+	std::unique_ptr<JobSystem> owned_job_system;
+	JobSystem *job_system;
+	EntityRegistry entities;
+	RenderSystem render_system;
+	Player *player;
+	EnemyManager *enemy_manager;
+	RandomStream random;
+	ColliderRegistry collider_registry;
+	CollisionLayerMatrix layer_matrix;
+	CollisionCounters collision_counters;
+	SpatialHash broadphase;
+	std::vector<std::pair<uint32_t, uint32_t>> colliding_pairs;
+	CollisionMode collision_mode;
+	CollisionScheduler collision_scheduler;
+	std::vector<std::pair<ColliderID, ColliderID>> scheduled_pairs;
+	CollisionEventQueue collision_events;
+	double tick_time;
 	Renderer *renderer;
-	static Input input;
-	std::string vert_uniform_buffer;
-	std::string frag_uniform_buffer;
-	std::string instance;
+	static Input keyboard_input;
+	Input input;
+	UniformBufferID vert_uniform_buffer;
+	UniformBufferID frag_uniform_buffer;
+	InstanceID instance;
 
 	glm::mat4 view;
 	glm::mat4 proj;
 	glm::mat4 transform;
 	float view_width;
 	float view_height;
-	float active_tiles[196];
+	FloorGrid floor_grid;
 	double score;
 
-	Font *font;
+	const Font *font;
 
 	PauseScreen *pause_screen;
 	DeathScreen *death_screen;
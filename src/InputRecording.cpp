@@ -0,0 +1,166 @@
+#include "InputRecording.h"
+
+#include <fstream>
+#include <stdexcept>
+
+// File layout: magic, version, seed, tick rate, tick count, run count, then each run as a button byte and a tick count
+const char recording_magic[4] = { 'D', 'B', 'R', 'P' };
+const uint32_t recording_version = 1;
+
+// One bit per button
+static uint8_t pack_input(const Input &input)
+{
+	return (input.up ? 1 : 0) | (input.down ? 2 : 0) | (input.left ? 4 : 0) | (input.right ? 8 : 0) | (input.w ? 16 : 0) | (input.esc ? 32 : 0) | (input.enter ? 64 : 0);
+}
+
+static Input unpack_input(uint8_t buttons)
+{
+	Input input = {};
+	input.up = (buttons & 1) != 0;
+	input.down = (buttons & 2) != 0;
+	input.left = (buttons & 4) != 0;
+	input.right = (buttons & 8) != 0;
+	input.w = (buttons & 16) != 0;
+	input.esc = (buttons & 32) != 0;
+	input.enter = (buttons & 64) != 0;
+
+	return input;
+}
+
+template <typename T>
+static void write_value(std::ofstream &file, const T &value)
+{
+	file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+static void read_value(std::ifstream &file, T &value)
+{
+	file.read(reinterpret_cast<char *>(&value), sizeof(T));
+}
+
+InputRecorder::InputRecorder(uint32_t seed, double tick_rate)
+{
+	this->seed = seed;
+	this->tick_rate = tick_rate;
+	tick_count = 0;
+}
+
+void InputRecorder::record(const Input &input)
+{
+	uint8_t buttons = pack_input(input);
+
+	// Extend the current run if nothing changed
+	if (!runs.empty() && runs.back().buttons == buttons && runs.back().ticks < UINT32_MAX)
+	{
+		runs.back().ticks++;
+	}
+	else
+	{
+		runs.push_back({ buttons, 1 });
+	}
+
+	tick_count++;
+}
+
+void InputRecorder::save(const std::string &file_name) const
+{
+	std::ofstream file(file_name, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Could not open " + file_name + " to save the recording!");
+	}
+
+	file.write(recording_magic, sizeof(recording_magic));
+	write_value(file, recording_version);
+	write_value(file, seed);
+	write_value(file, tick_rate);
+	write_value(file, tick_count);
+	write_value(file, static_cast<uint64_t>(runs.size()));
+
+	for (const auto &run : runs)
+	{
+		write_value(file, run.buttons);
+		write_value(file, run.ticks);
+	}
+}
+
+InputPlayback::InputPlayback(const std::string &file_name)
+{
+	std::ifstream file(file_name, std::ios::binary);
+
+	if (!file.is_open())
+	{
+		throw std::runtime_error("Could not open recording " + file_name + "!");
+	}
+
+	char magic[4];
+	uint32_t version;
+	uint64_t run_count;
+
+	file.read(magic, sizeof(magic));
+	read_value(file, version);
+
+	if (!file || std::string(magic, 4) != std::string(recording_magic, 4) || version != recording_version)
+	{
+		throw std::runtime_error(file_name + " is not a recording this version can play!");
+	}
+
+	read_value(file, seed);
+	read_value(file, tick_rate);
+	read_value(file, tick_count);
+	read_value(file, run_count);
+
+	auto loaded_runs = std::make_shared<std::vector<InputRun>>(run_count);
+	for (auto &run : *loaded_runs)
+	{
+		read_value(file, run.buttons);
+		read_value(file, run.ticks);
+	}
+
+	if (!file)
+	{
+		throw std::runtime_error("Recording " + file_name + " is truncated!");
+	}
+
+	runs = loaded_runs;
+
+	current_run = 0;
+	ticks_into_run = 0;
+}
+
+bool InputPlayback::next(Input &input)
+{
+	// Skip past runs that have been used up
+	while (current_run < runs->size() && ticks_into_run >= (*runs)[current_run].ticks)
+	{
+		current_run++;
+		ticks_into_run = 0;
+	}
+
+	if (current_run >= runs->size())
+	{
+		return false;
+	}
+
+	input = unpack_input((*runs)[current_run].buttons);
+	ticks_into_run++;
+
+	return true;
+}
+
+uint32_t InputPlayback::get_seed() const
+{
+	return seed;
+}
+
+double InputPlayback::get_tick_rate() const
+{
+	return tick_rate;
+}
+
+uint64_t InputPlayback::get_tick_count() const
+{
+	return tick_count;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "GameManager.h"
+
+// Stretch of consecutive ticks that all saw the same input
+struct InputRun
+{
+	uint8_t buttons;
+	uint32_t ticks;
+};
+
+// Records the input every simulation tick sees, along with the random seed and tick rate, so the run can be replayed exactly
+class InputRecorder
+{
+public:
+	InputRecorder(uint32_t seed, double tick_rate);
+
+	// Call once per tick with the input that tick's update will see
+	void record(const Input &input);
+
+	void save(const std::string &file_name) const;
+
+private:
+	uint32_t seed;
+	double tick_rate;
+	uint64_t tick_count;
+	std::vector<InputRun> runs;
+};
+
+// Plays back a recording made by InputRecorder one tick at a time. Copies share the recording but keep their own place in it,
+// so one file can be read once and played by many games.
+class InputPlayback
+{
+public:
+	InputPlayback(const std::string &file_name);
+
+	// Fills input with the next tick's input. Returns false once the recording has run out.
+	bool next(Input &input);
+
+	uint32_t get_seed() const;
+	double get_tick_rate() const;
+	uint64_t get_tick_count() const;
+
+private:
+	uint32_t seed;
+	double tick_rate;
+	uint64_t tick_count;
+	std::shared_ptr<const std::vector<InputRun>> runs;
+
+	size_t current_run;
+	uint32_t ticks_into_run;
+};
@@ -0,0 +1,191 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+// Which system's worker this thread is, and which queue it owns. Threads that aren't workers share queue 0.
+static thread_local const JobSystem *worker_system = nullptr;
+static thread_local uint32_t worker_index = 0;
+
+JobSystem::JobSystem(uint32_t thread_count)
+{
+	if (thread_count == 0)
+	{
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	this->thread_count = thread_count;
+	running = true;
+	queued_jobs = 0;
+
+	for (uint32_t i = 0; i < thread_count; i++)
+	{
+		queues.push_back(std::make_unique<JobQueue>());
+	}
+
+	// The creating thread is worker 0, so only start the rest
+	for (uint32_t i = 1; i < thread_count; i++)
+	{
+		threads.emplace_back(&JobSystem::worker_loop, this, i);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		running = false;
+	}
+	wake_workers.notify_all();
+
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+}
+
+void JobSystem::run(std::function<void()> job, JobCounter *counter)
+{
+	counter->count.fetch_add(1, std::memory_order_relaxed);
+
+	// Single threaded systems have nobody else to hand the job to
+	if (thread_count == 1)
+	{
+		job();
+		counter->count.fetch_sub(1, std::memory_order_release);
+		return;
+	}
+
+	JobQueue &queue = *queues[current_queue()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back({ std::move(job), counter });
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		queued_jobs++;
+	}
+	wake_workers.notify_one();
+}
+
+void JobSystem::wait(JobCounter *counter)
+{
+	uint32_t index = current_queue();
+
+	while (counter->count.load(std::memory_order_acquire) > 0)
+	{
+		// Help out instead of blocking
+		if (!try_run_job(index))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &body)
+{
+	if (end <= begin)
+	{
+		return;
+	}
+
+	grain = std::max<size_t>(1, grain);
+
+	const size_t count = end - begin;
+	if (thread_count == 1 || count <= grain)
+	{
+		body(begin, end);
+		return;
+	}
+
+	// A few chunks per thread so threads that finish early can steal the rest
+	size_t chunks = std::min((count + grain - 1) / grain, static_cast<size_t>(thread_count) * 4);
+	size_t chunk_size = (count + chunks - 1) / chunks;
+
+	JobCounter counter;
+	for (size_t chunk_begin = begin; chunk_begin < end; chunk_begin += chunk_size)
+	{
+		size_t chunk_end = std::min(end, chunk_begin + chunk_size);
+		run([&body, chunk_begin, chunk_end]() { body(chunk_begin, chunk_end); }, &counter);
+	}
+
+	wait(&counter);
+}
+
+uint32_t JobSystem::get_thread_count() const
+{
+	return thread_count;
+}
+
+void JobSystem::worker_loop(uint32_t index)
+{
+	worker_system = this;
+	worker_index = index;
+
+	while (true)
+	{
+		if (try_run_job(index))
+		{
+			continue;
+		}
+
+		// Sleep until there is something to do
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		wake_workers.wait(lock, [this]() { return !running || queued_jobs > 0; });
+
+		if (!running)
+		{
+			return;
+		}
+	}
+}
+
+bool JobSystem::try_run_job(uint32_t index)
+{
+	Job job;
+	bool found = false;
+
+	// Newest job from our own queue first, it's the most likely to still be in cache
+	{
+		JobQueue &queue = *queues[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			found = true;
+		}
+	}
+
+	// Otherwise steal the oldest job from someone else
+	for (uint32_t i = 1; i < thread_count && !found; i++)
+	{
+		JobQueue &queue = *queues[(index + i) % thread_count];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			found = true;
+		}
+	}
+
+	if (!found)
+	{
+		return false;
+	}
+
+	queued_jobs--;
+
+	job.function();
+	job.counter->count.fetch_sub(1, std::memory_order_release);
+
+	return true;
+}
+
+uint32_t JobSystem::current_queue() const
+{
+	return worker_system == this ? worker_index : 0;
+}
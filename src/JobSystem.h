@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Number of jobs still to finish in a group. Jobs decrement it when they complete, and wait() blocks until it reaches zero.
+struct JobCounter
+{
+	std::atomic<uint32_t> count{ 0 };
+};
+
+// Runs jobs on a fixed set of worker threads. Every thread has its own queue, takes work from the back of it,
+// and steals from the front of other threads' queues when it runs dry. Threads that wait on a counter run jobs
+// while they wait, so jobs can safely start and wait on more jobs.
+class JobSystem
+{
+public:
+	// thread_count includes the thread that creates the system. 0 uses one thread per hardware thread, 1 runs every job on the calling thread.
+	JobSystem(uint32_t thread_count = 0);
+	~JobSystem();
+
+	// Queues a job, adding one to counter until it finishes
+	void run(std::function<void()> job, JobCounter *counter);
+
+	// Runs queued jobs until counter reaches zero
+	void wait(JobCounter *counter);
+
+	// Splits [begin, end) into chunks of at least grain elements and calls body(chunk_begin, chunk_end) for each,
+	// returning once every chunk has run. Ranges no bigger than grain run directly on the calling thread.
+	void parallel_for(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &body);
+
+	uint32_t get_thread_count() const;
+
+	JobSystem(const JobSystem&) = delete;
+
+private:
+	struct Job
+	{
+		std::function<void()> function;
+		JobCounter *counter;
+	};
+
+	struct JobQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	void worker_loop(uint32_t index);
+	bool try_run_job(uint32_t index);
+	uint32_t current_queue() const;
+
+	uint32_t thread_count;
+	std::vector<std::unique_ptr<JobQueue>> queues;
+	std::vector<std::thread> threads;
+
+	std::atomic<bool> running;
+	std::atomic<uint32_t> queued_jobs;
+	std::mutex sleep_mutex;
+	std::condition_variable wake_workers;
+};
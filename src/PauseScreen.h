@@ -1,48 +1,29 @@
 #pragma once
+#include "Renderer/Renderer.h"
 #include "Text.h"
 
 #include <string>
 
 #include "SoundManager.h"
 
-struct SquareUniform
+class PauseScreen
 {
-	glm::mat4 model;
-	glm::mat4 view;
-	glm::mat4 proj;
-	float time;
-};
+public:
+	PauseScreen(Renderer *renderer, EntityRegistry *entities, const Font *font);
+	~PauseScreen();
 
-struct PauseDarkenUniform
-{
-	glm::mat4 model;
-	glm::mat4 view;
-	glm::mat4 proj;
-};
+	// The screen's entities are only drawn while it's visible
+	void set_visible(bool visible);
 
-class PauseScreen : public GameObject
-{
-public:
-	PauseScreen(Renderer *renderer, Font *font);
-	virtual ~PauseScreen();
-	virtual void update(double time);
-	virtual std::vector<Rectangle *> get_collider();
-	virtual void submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height) const;
-	virtual void handle_external_collisions(const Rectangle *collider, const GameObject *other);
-	virtual void pause();
-	virtual void unpause();
+	PauseScreen(const PauseScreen&) = delete;
 
 private:
 	Renderer *renderer;
-
-	glm::vec3 location;
+	EntityRegistry *entities;
 
 	Text text;
-	std::string square_uniform_buffer;
-	std::string square_instance;
 
-	std::string screen_darken_uniform_buffer;
-	std::string screen_darken_instance;
-
-	float run_time;
-};
\ No newline at end of file
+	// Animated square behind the text and a quad darkening the arena
+	EntityID square;
+	EntityID screen_darken;
+};
@@ -1,44 +1,69 @@
 #include "Player.h"
+#include "Systems.h"
 
 #include "glm/gtc/matrix_transform.hpp"
 
-Player::Player(Renderer *renderer, Input *input, bool *game_end_flag)
+Player::Player(Renderer *renderer, EntityRegistry *entities, ColliderRegistry *collider_registry, Input *input, bool *game_end_flag)
 	: sound_manager(&SoundManager::get_instance())
 {
 	this->renderer = renderer;
+	this->entities = entities;
+	this->collider_registry = collider_registry;
 	game_end = game_end_flag;
-	scale = glm::scale(glm::mat4(1), glm::vec3(scale_factor, scale_factor, scale_factor));
-	location = glm::vec2(0.0, 0.0);
 	state = PLAYER_DEFAULT;
 
 	current_dash_time = 0;
-	current_death_time = 0;
 
 	this->input = input;
+	input_w_released = false;
 
-	type = 0;
+	// -(0.5 - (scale_factor / 2.f) - 0.001f) is the distance to put the cube so that the bottom is touching the floor
+	Transform transform = {};
+	transform.location = glm::vec2(0.0, 0.0);
+	transform.previous_location = transform.location;
+	transform.depth = -(0.5f - (scale_factor / 2.f) - 0.001f);
+	transform.scale = glm::vec3(scale_factor);
 
 	UniformBufferParameters uniform_parameters = {};
-	uniform_parameters.size = sizeof(PlayerUniform);
+	uniform_parameters.size = sizeof(MeshUniform);
 
-	uniform_buffer = get_uniform_buffer(*renderer, uniform_parameters);
+	RenderHandle render = {};
+	render.kind = RENDER_KIND_MESH;
+	render.visible = true;
+	render.uniform_buffer = create_uniform_buffer(*renderer, uniform_parameters);
 
 	LightParameters light_parameters = {};
 	light_parameters.color = glm::vec3(0.23, 0.11, 0.96);
 	light_parameters.intensity = 0.3f;
 	light_parameters.max_distance = 0.8f;
-	light_parameters.location = glm::vec3(location, 1.0);
+	light_parameters.location = glm::vec3(transform.location, 1.0);
 	light_parameters.type = LIGHT_POINT;
-	light = create_light(*renderer, light_parameters);
-	light_location = glm::vec2(0.0, 0.0);
+
+	LightHandle light = {};
+	light.light = create_light(*renderer, light_parameters);
+	light.color = glm::vec3(0.113, 0.294, 0.95);
+	light.intensity = 2.0f;
+	light.max_distance = 3.0f;
+	light.offset = glm::vec2(0.0, 0.0);
+	light.enabled = true;
 
 	InstanceParameters instance_parameters = {};
 	instance_parameters.material = MATERIAL_BLUE_CUBE;
-	instance_parameters.uniform_buffers = { { uniform_buffer }, { uniform_buffer } };
+	instance_parameters.uniform_buffers = { { render.uniform_buffer }, { render.uniform_buffer } };
+
+	render.instance = create_instance(*renderer, instance_parameters);
 
-	instance = create_instance(*renderer, instance_parameters);
+	ColliderHandle collider = {};
+	collider.collider = collider_registry->add(collider_registry->add_owner(), 0, COLLISION_LAYER_PLAYER);
+	collider.size = glm::vec2(scale_factor, scale_factor);
+	collider.follow = true;
+	collider_registry->get(collider.collider).set_placement(transform.location + glm::vec2(-0.1, -0.1), glm::vec2(0.2, 0.2));
 
-	collider.set_placement(location + glm::vec2(-0.1, -0.1), glm::vec2(0.2, 0.2));
+	// Input can send the player any direction, but never faster than a dash
+	ColliderMotion motion = {};
+	motion.type = COLLIDER_MOTION_BOUNDED;
+	motion.max_speed = dash_speed;
+	collider_registry->set_motion(collider.collider, motion);
 
 	sound_manager->update_listener_position(0.0, 0.0, 0.0);
 	sound_manager->update_listener_velocity(0.0, 0.0, 0.0);
@@ -59,6 +84,20 @@ Player::Player(Renderer *renderer, Input *input, bool *game_end_flag)
 	sound_manager->update_sound_loop(death_sound, false);
 
 	sound_manager->update_listener_orientation(0.0, 0.0, 1.0, 0.0, -1.0, 0.0);
+
+	// Both sounds play relative to the listener, which follows the player
+	AudioHandle audio = {};
+	audio.sounds[0] = dash_sound;
+	audio.sounds[1] = death_sound;
+	audio.sound_count = 2;
+	audio.positional = false;
+
+	entity = entities->create();
+	entities->transforms.add(entity, transform);
+	entities->colliders.add(entity, collider);
+	entities->renders.add(entity, render);
+	entities->lights.add(entity, light);
+	entities->sounds.add(entity, audio);
 }
 
 Player::~Player()
@@ -68,19 +107,28 @@ Player::~Player()
 	if (renderer->device.device != VK_NULL_HANDLE)
 	{
 		// Free resources
-		free_uniform_buffer(*renderer, uniform_buffer);
-		free_instance(*renderer, instance);
-		free_light(*renderer, light);
+		const RenderHandle &render = entities->renders.get(entity);
+		free_uniform_buffer(*renderer, render.uniform_buffer);
+		free_instance(*renderer, render.instance);
+		free_light(*renderer, entities->lights.get(entity).light);
 	}
 
 	sound_manager->delete_sound(death_sound);
 	sound_manager->delete_sound(dash_sound);
+
+	collider_registry->remove(entities->colliders.get(entity).collider);
+	entities->destroy(entity);
 }
 
 void Player::update(double time)
 {
 	bool play_dash_sound = false;
 
+	Transform &transform = entities->transforms.get(entity);
+	glm::vec2 &location = transform.location;
+	glm::vec2 &light_location = entities->lights.get(entity).offset;
+	transform.previous_location = location;
+
 	if (state == PLAYER_DEFAULT || state == PLAYER_DASHING)
 	{
 		glm::vec2 direction(0.0);
@@ -186,9 +234,6 @@ void Player::update(double time)
 			location.y = -0.74f;
 		}
 
-		// Update collider
-		collider.set_placement(location + glm::vec2(-scale_factor / 2.f, -scale_factor / 2.f), glm::vec2(scale_factor, scale_factor));
-
 		// Update listener information
 		sound_manager->update_listener_position(location.x, location.y, 0.f);
 
@@ -208,9 +253,9 @@ void Player::update(double time)
 	}
 	else if (state == PLAYER_DYING)
 	{
-		// Play death animation if dying
-		current_death_time += float(time);
-		scale = glm::scale(glm::mat4(1), glm::vec3(scale_factor, scale_factor, scale_factor)) * glm::scale(glm::mat4(1), glm::vec3((0.1f + total_death_time - current_death_time) / (0.1f + total_death_time)));
+		// Play death animation if dying. The lifetime system counts how long it's been going.
+		float current_death_time = entities->lifetimes.get(entity).elapsed;
+		transform.scale = glm::vec3(scale_factor * (0.1f + total_death_time - current_death_time) / (0.1f + total_death_time));
 
 		light_location = (current_death_time / total_death_time) * glm::vec2(0.0f, 0.0f) + ((total_death_time - current_death_time) / total_death_time) * light_location;
 
@@ -218,10 +263,14 @@ void Player::update(double time)
 		{
 			// Once you're done with the animation, you're dead
 			state = PLAYER_DEAD;
+			entities->renders.get(entity).visible = false;
+			entities->lights.get(entity).enabled = false;
 		}
 
 		// Set collider out of bounds so other enemies don't collide with it
-		collider.set_placement(glm::vec2(40, 40), glm::vec2(0, 0));
+		ColliderHandle &collider = entities->colliders.get(entity);
+		collider.follow = false;
+		collider_registry->get(collider.collider).set_placement(glm::vec2(40, 40), glm::vec2(0, 0));
 
 		sound_manager->update_listener_position(40, 40, 0.0);
 	}
@@ -233,81 +282,28 @@ void Player::update(double time)
 
 }
 
-std::vector<Rectangle *> Player::get_collider()
-{
-	return { &collider };
-}
-
-void Player::submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height) const
+void Player::submit_for_rendering(float interpolation) const
 {
 	if (state != PLAYER_DEAD)
 	{
-		update_reflection_map(*renderer, glm::vec3(location, -(0.5 - (scale_factor / 2.f) - 0.001f)));
-
-		// Update light
-		LightUpdateParameters light_update_parameters = {};
-		light_update_parameters.light_index = light;
-		light_update_parameters.color = glm::vec3(0.113, 0.294, 0.95);
-		light_update_parameters.intensity = /*2.5f*/ 2.0f /*0.f*/;
-		light_update_parameters.max_distance = 3.0f;
-
-		// -(0.5 - (scale_factor / 2.f) - 0.001f) is the distance to put the cube so that the bottom is touching the floor
-		light_update_parameters.location = glm::vec3(location + light_location, -(0.5 - (scale_factor / 2.f) - 0.001f));
-		update_light(*renderer, light_update_parameters);
-
-		// Update uniform buffer
-		PlayerUniform uniform_buffer_data;
-		uniform_buffer_data.model = glm::translate(glm::mat4(1), glm::vec3(location.x * width, location.y * height, -(0.5 - (scale_factor / 2.f) - 0.001f))) * scale;
-		uniform_buffer_data.view = view;
-		uniform_buffer_data.proj = proj;
-		uniform_buffer_data.light_index = light;
+		// Reflect the player where the render system draws it, between the last two ticks
+		const Transform &transform = entities->transforms.get(entity);
+		glm::vec2 draw_location = glm::mix(transform.previous_location, transform.location, interpolation);
 
-		UniformBufferUpdateParameters update_parameters = {};
-		update_parameters.buffer_name = uniform_buffer;
-		update_parameters.data = &uniform_buffer_data;
-
-		update_uniform_buffer(*(this->renderer), update_parameters);
-
-		InstanceSubmitParameters submit_parameters = {};
-		submit_parameters.instance_name = instance;
-
-		submit_instance(*(this->renderer), submit_parameters);
+		update_reflection_map(*renderer, glm::vec3(draw_location, transform.depth));
 	}
 }
 
-void Player::handle_external_collisions(const Rectangle *collider, const GameObject *other)
+void Player::handle_enemy_collision()
 {
-	if ((state == PLAYER_DEFAULT || state == PLAYER_DASHING) && other->type == 1)
+	if (state == PLAYER_DEFAULT || state == PLAYER_DASHING)
 	{
 		sound_manager->play_sound(death_sound);
 		state = PLAYER_DYING;
-	}
-}
-
-void Player::pause()
-{
-	resume_dash = sound_manager->is_sound_playing(dash_sound);
-	if (resume_dash)
-	{
-		sound_manager->pause_sound(dash_sound);
-	}
-
-	resume_death = sound_manager->is_sound_playing(death_sound);
-	if (resume_death)
-	{
-		sound_manager->pause_sound(death_sound);
-	}
-}
-
-void Player::unpause()
-{
-	if (resume_dash)
-	{
-		sound_manager->play_sound(dash_sound);
-	}
 
-	if (resume_death)
-	{
-		sound_manager->play_sound(death_sound);
+		// Times the death animation
+		Lifetime lifetime = {};
+		lifetime.duration = total_death_time;
+		entities->lifetimes.add(entity, lifetime);
 	}
 }
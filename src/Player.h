@@ -1,21 +1,13 @@
 #pragma once
 
 #include "Renderer/Renderer.h"
-#include "GameObject.h"
+#include "EntityRegistry.h"
 #include <glm/mat4x4.hpp>
 
 #include "SoundManager.h"
 
 #include "GameManager.h"
 
-struct PlayerUniform
-{
-	glm::mat4 model;
-	glm::mat4 view;
-	glm::mat4 proj;
-	int light_index;
-};
-
 enum PlayerState
 {
 	PLAYER_DEFAULT = 0,
@@ -24,28 +16,26 @@ enum PlayerState
 	PLAYER_DEAD = 3
 };
 
-class Player : public GameObject
+class Player
 {
 public:
-	Player(Renderer *renderer, Input *input, bool *game_end_flag);
-	virtual ~Player();
-	virtual void update(double time);
-	virtual std::vector<Rectangle *> get_collider();
-	virtual void submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height) const;
-	virtual void handle_external_collisions(const Rectangle *collider, const GameObject *other);
-	virtual void pause();
-	virtual void unpause();
+	Player(Renderer *renderer, EntityRegistry *entities, ColliderRegistry *collider_registry, Input *input, bool *game_end_flag);
+	~Player();
+	void update(double time);
+
+	// Draws the player into the reflection map. Everything else about the player is drawn by the render system.
+	void submit_for_rendering(float interpolation) const;
+
+	void handle_enemy_collision();
+
+	Player(const Player&) = delete;
 
-	glm::vec2 location;
 private:
 	Renderer *renderer;
-	std::string instance;
-	std::string uniform_buffer;
-	uint8_t light;
-	glm::vec2 light_location;
+	EntityRegistry *entities;
+	EntityID entity;
 
-	glm::mat4 scale;
-	Rectangle collider;
+	ColliderRegistry *collider_registry;
 	const Input *input;
 	bool *game_end;
 
@@ -57,14 +47,11 @@ private:
 
 	glm::vec2 dash_direction;
 	float current_dash_time;
-	float current_death_time;
 
 	PlayerState state;
 
 	size_t dash_sound;
-	bool resume_dash;
 	size_t death_sound;
-	bool resume_death;
 	SoundManager *sound_manager;
 
 	bool input_w_released;
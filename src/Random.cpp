@@ -0,0 +1,34 @@
+#include "Random.h"
+
+// Spreads the bits of a seed out so similar seeds still start far apart (splitmix64)
+static uint64_t split_mix(uint64_t &value)
+{
+	uint64_t z = (value += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+RandomStream::RandomStream(uint64_t seed, uint64_t stream)
+{
+	this->seed(seed, stream);
+}
+
+void RandomStream::seed(uint64_t seed, uint64_t stream)
+{
+	uint64_t mixer = seed ^ split_mix(stream);
+
+	const uint64_t low = split_mix(mixer);
+	const uint64_t high = split_mix(mixer);
+
+	state[0] = static_cast<uint32_t>(low);
+	state[1] = static_cast<uint32_t>(low >> 32);
+	state[2] = static_cast<uint32_t>(high);
+	state[3] = static_cast<uint32_t>(high >> 32);
+
+	// An all zero state would only ever produce zeros
+	if ((state[0] | state[1] | state[2] | state[3]) == 0)
+	{
+		state[0] = 1;
+	}
+}
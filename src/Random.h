@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stdint.h>
+
+// Small, fast random number stream (xoshiro128**). Each game owns its own stream, so games running side by side
+// never share state and a game started from the same seed always makes the same choices.
+class RandomStream
+{
+public:
+	// Different stream numbers with the same seed give unrelated sequences
+	RandomStream(uint64_t seed, uint64_t stream = 0);
+
+	void seed(uint64_t seed, uint64_t stream = 0);
+
+	uint32_t next()
+	{
+		const uint32_t result = rotate_left(state[1] * 5, 7) * 9;
+		const uint32_t t = state[1] << 9;
+
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+
+		state[2] ^= t;
+		state[3] = rotate_left(state[3], 11);
+
+		return result;
+	}
+
+	// Uniform integer from low to high inclusive
+	int range(int low, int high)
+	{
+		const uint32_t span = static_cast<uint32_t>(high - low) + 1;
+
+		// The full 32 bit range needs no scaling
+		if (span == 0)
+		{
+			return static_cast<int>(next());
+		}
+
+		// Scale into the span with a multiply, rejecting the few values that would make some results more likely than others
+		uint64_t product = uint64_t(next()) * span;
+		if (static_cast<uint32_t>(product) < span)
+		{
+			const uint32_t threshold = (0u - span) % span;
+			while (static_cast<uint32_t>(product) < threshold)
+			{
+				product = uint64_t(next()) * span;
+			}
+		}
+
+		return low + static_cast<int>(product >> 32);
+	}
+
+	// Uniform float from 0 up to but not including 1
+	float uniform()
+	{
+		return (next() >> 8) * (1.f / 16777216.f);
+	}
+
+private:
+	static uint32_t rotate_left(uint32_t value, int count)
+	{
+		return (value << count) | (value >> (32 - count));
+	}
+
+	uint32_t state[4];
+};
@@ -7,6 +7,7 @@
 *PATH_TO_glglc*/glslc.exe vert_standard_tex_coord.vert -o vert_standard_tex_coord.spv
 *PATH_TO_glglc*/glslc.exe vert_standard_light_index.vert -o vert_standard_light_index.spv
 *PATH_TO_glglc*/glslc.exe vert_text.vert -o vert_text.spv
+*PATH_TO_glglc*/glslc.exe vert_text_batch.vert -o vert_text_batch.spv
 *PATH_TO_glglc*/glslc.exe frag_pause_screen.frag -o frag_pause_screen.spv
 *PATH_TO_glglc*/glslc.exe frag_death_screen.frag -o frag_death_screen.spv
 *PATH_TO_glglc*/glslc.exe frag_red.frag -o frag_red.spv
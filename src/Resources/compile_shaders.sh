@@ -7,6 +7,7 @@ glslc vert_darken.vert -o vert_darken.spv
 glslc vert_standard_tex_coord.vert -o vert_standard_tex_coord.spv
 glslc vert_standard_light_index.vert -o vert_standard_light_index.spv
 glslc vert_text.vert -o vert_text.spv
+glslc vert_text_batch.vert -o vert_text_batch.spv
 glslc frag_pause_screen.frag -o frag_pause_screen.spv
 glslc frag_death_screen.frag -o frag_death_screen.spv
 glslc frag_red.frag -o frag_red.spv
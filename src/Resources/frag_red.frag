@@ -4,7 +4,8 @@
 layout(location = 0) out vec4 outColor;
 
 layout(binding = 1) uniform ActiveTiles {
-	float isActive[196];
+	int gridSize;
+	vec4 isActive[256];
 } tiles;
 
 layout(binding = 2) uniform LightObject {
@@ -68,7 +69,7 @@ layout(location = 2) flat in vec3 normal;
 layout(location = 3) flat in vec3 inCameraPos;
 
 void main() {
-	float numGridCells = 14.0;
+	float numGridCells = float(tiles.gridSize);
 
 	float xGridCell = floor(((inPosition.x + 1.0355) / 2.071) * numGridCells);
 	float yGridCell = floor(((inPosition.y + 1.0355) / 2.071) * numGridCells);
@@ -85,7 +86,9 @@ void main() {
 	float yCellLowBound = yCellWidth * .1;
 	float yCellHighBound = yCellWidth - yCellLowBound;
 
-	float ambient_intensity = 0.6 * tiles.isActive[int(xGridCell * 14 + yGridCell)] * step(xCellLeftBound, xCellPosition) * step(xCellPosition, xCellRightBound) * step(yCellLowBound, yCellPosition) * step(yCellPosition, yCellHighBound) + 0.17;
+	int tileIndex = int(xGridCell) * tiles.gridSize + int(yGridCell);
+
+	float ambient_intensity = 0.6 * tiles.isActive[tileIndex / 4][tileIndex % 4] * step(xCellLeftBound, xCellPosition) * step(xCellPosition, xCellRightBound) * step(yCellLowBound, yCellPosition) * step(yCellPosition, yCellHighBound) + 0.17;
 	vec3 ambient_color = ambient_intensity * vec3(0.65, 0.1, 0.12);
 
 	vec3 diffuse_color[14];
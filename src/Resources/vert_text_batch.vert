@@ -0,0 +1,18 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout(location = 0) out vec2 outTexCoord;
+
+// Already placed in the world and in the font texture by update_text_batch
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec2 inTexCoord;
+
+void main() {
+	outTexCoord = inTexCoord;
+    gl_Position = ubo.proj * ubo.view * vec4(inPosition, 1.0);
+}
\ No newline at end of file
@@ -4,8 +4,15 @@
 #include <fstream>
 #include <cstring>
 
+SoundBackend SoundManager::selected_backend = SOUND_BACKEND_OPENAL;
+
 SoundManager::~SoundManager()
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	alDeleteBuffers(static_cast<ALsizei>(buffers.size()), buffers.data());
 	alcMakeContextCurrent(NULL);
 	alcDestroyContext(context);
@@ -14,12 +21,23 @@ SoundManager::~SoundManager()
 
 SoundManager &SoundManager::get_instance()
 {
-	static SoundManager instance({ "Resources/dash_sound.wav", "Resources/death_sound.wav", "Resources/enemy_sound.wav", "Resources/menu_sound.wav", "Resources/music.wav" });
+	static SoundManager instance({ "Resources/dash_sound.wav", "Resources/death_sound.wav", "Resources/enemy_sound.wav", "Resources/menu_sound.wav", "Resources/music.wav" }, selected_backend);
 	return instance;
 }
 
+void SoundManager::select_backend(SoundBackend backend)
+{
+	// Only has an effect if called before the first call to get_instance
+	selected_backend = backend;
+}
+
 size_t SoundManager::register_sound(SoundType type)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return 0;
+	}
+
 	ALuint source;
 	alGenSources(1, &source);
 	alSourcei(source, AL_BUFFER, buffers[type]);
@@ -30,43 +48,83 @@ size_t SoundManager::register_sound(SoundType type)
 
 void SoundManager::delete_sound(size_t sound)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	alDeleteSources(1, &sources[sound]);
 }
 
 void SoundManager::update_sound_position(size_t sound, float x, float y, float z)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	ALfloat source_pos[] = { x, y, z };
 	alSourcefv(sources[sound], AL_POSITION, source_pos);
 }
 
 void SoundManager::update_sound_velocity(size_t sound, float x, float y, float z)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	ALfloat source_vel[] = { x, y, z };
 	alSourcefv(sources[sound], AL_VELOCITY, source_vel);
 }
 
 void SoundManager::update_sound_loop(size_t sound, bool loop)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	alSourcei(sources[sound], AL_LOOPING, ALboolean(loop));
 }
 
 void SoundManager::update_sound_relative(size_t sound, bool relative)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	alSourcei(sources[sound], AL_SOURCE_RELATIVE, relative);
 }
 
 void SoundManager::update_sound_max_distance(size_t sound, float max_distance)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	alSourcef(sources[sound], AL_REFERENCE_DISTANCE, max_distance);
 }
 
 void SoundManager::update_sound_gain(size_t sound, float gain)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	alSourcef(sources[sound], AL_GAIN, gain);
 }
 
 bool SoundManager::is_sound_playing(size_t sound)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return false;
+	}
+
 	ALint state;
 	alGetSourcei(sources[sound], AL_SOURCE_STATE, &state);
 
@@ -75,6 +133,11 @@ bool SoundManager::is_sound_playing(size_t sound)
 
 void SoundManager::play_sound(size_t sound)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	ALint state;
 	alGetSourcei(sources[sound], AL_SOURCE_STATE, &state);
 
@@ -88,16 +151,31 @@ void SoundManager::play_sound(size_t sound)
 
 void SoundManager::pause_sound(size_t sound)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	alSourcePause(sources[sound]);
 }
 
 void SoundManager::stop_sound(size_t sound)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	alSourceStop(sources[sound]);
 }
 
 void SoundManager::update_listener_position(float x, float y, float z)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	listener_location = { x, y, z };
 
 	ALfloat listener_pos[] = { x, y, z };
@@ -106,6 +184,11 @@ void SoundManager::update_listener_position(float x, float y, float z)
 
 void SoundManager::update_listener_velocity(float x, float y, float z)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	listener_velocity = { x, y, z };
 
 	ALfloat listener_vel[] = { x, y, z };
@@ -114,6 +197,11 @@ void SoundManager::update_listener_velocity(float x, float y, float z)
 
 void SoundManager::update_listener_orientation(float at_x, float at_y, float at_z, float up_x, float up_y, float up_z)
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	ALfloat listener_ori[] = { at_x, at_y, at_z, up_x, up_y, up_z };
 	alListenerfv(AL_ORIENTATION, listener_ori);
 }
@@ -130,6 +218,11 @@ glm::vec3 SoundManager::get_listener_velocity()
 
 void SoundManager::reset()
 {
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	for (auto source : sources)
 	{
 		ALenum source_state;
@@ -144,8 +237,20 @@ void SoundManager::reset()
 	}
 }
 
-SoundManager::SoundManager(std::vector<std::string> sound_files)
+SoundManager::SoundManager(std::vector<std::string> sound_files, SoundBackend backend)
 {
+	this->backend = backend;
+	listener_location = glm::vec3(0.f, 0.f, 0.f);
+	listener_velocity = glm::vec3(0.f, 0.f, 0.f);
+	device = nullptr;
+	context = nullptr;
+
+	// The null backend never opens a device, so every other call becomes a no-op
+	if (backend == SOUND_BACKEND_NULL)
+	{
+		return;
+	}
+
 	// Setup audio device and context
 	device = alcOpenDevice(NULL);
 
@@ -17,6 +17,12 @@ enum SoundType
 	SOUND_TYPE_MUSIC = 4
 };
 
+enum SoundBackend
+{
+	SOUND_BACKEND_OPENAL = 0,
+	SOUND_BACKEND_NULL = 1
+};
+
 struct WAVInfo
 {
 	ALvoid *data;
@@ -31,6 +37,7 @@ class SoundManager
 public:
 	~SoundManager();
 	static SoundManager &get_instance();
+	static void select_backend(SoundBackend backend);
 	size_t register_sound(SoundType type);
 	void delete_sound(size_t sound);
 	void update_sound_position(size_t sound, float x, float y, float z);
@@ -54,7 +61,7 @@ public:
 	glm::vec3 get_listener_velocity();
 
 private:
-	SoundManager(std::vector<std::string> sound_files);
+	SoundManager(std::vector<std::string> sound_files, SoundBackend backend);
 	void load_wav_file(std::string file_name, WAVInfo &info);
 	void free_wav_file(WAVInfo &info);
 
@@ -66,4 +73,7 @@ private:
 
 	ALCdevice *device;
 	ALCcontext *context;
+
+	SoundBackend backend;
+	static SoundBackend selected_backend;
 };
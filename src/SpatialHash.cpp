@@ -0,0 +1,243 @@
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float cell_size)
+{
+	this->cell_size = cell_size;
+	inverse_cell_size = 1.f / cell_size;
+	counters = {};
+}
+
+void SpatialHash::clear()
+{
+	// Keep the allocations around so a steady state frame doesn't allocate
+	entries.clear();
+	cells.clear();
+	cell_bounds.clear();
+}
+
+void SpatialHash::insert(const Rectangle *collider, uint32_t owner, CollisionLayer layer)
+{
+	uint32_t entry = static_cast<uint32_t>(entries.size());
+	entries.push_back({ collider, owner, layer });
+
+	// Find the range of cells the collider overlaps
+	int32_t min_x = to_cell(collider->position.x);
+	int32_t min_y = to_cell(collider->position.y);
+	int32_t max_x = to_cell(collider->position.x + collider->size.x);
+	int32_t max_y = to_cell(collider->position.y + collider->size.y);
+
+	for (int32_t x = min_x; x <= max_x; x++)
+	{
+		for (int32_t y = min_y; y <= max_y; y++)
+		{
+			cells.push_back({ cell_key(x, y), entry });
+		}
+	}
+}
+
+void SpatialHash::set_layer_matrix(const CollisionLayerMatrix &matrix)
+{
+	layer_matrix = matrix;
+}
+
+void SpatialHash::find_pairs(std::vector<std::pair<uint32_t, uint32_t>> &pairs, JobSystem *job_system)
+{
+	pairs.clear();
+	counters = {};
+
+	// Group cell entries so everything in the same cell is contiguous, within a cell everything on the same layer, and within a layer everything with the same owner
+	std::sort(cells.begin(), cells.end(), [this](const CellEntry &a, const CellEntry &b)
+	{
+		if (a.cell != b.cell)
+		{
+			return a.cell < b.cell;
+		}
+		if (entries[a.entry].layer != entries[b.entry].layer)
+		{
+			return entries[a.entry].layer < entries[b.entry].layer;
+		}
+		if (entries[a.entry].owner != entries[b.entry].owner)
+		{
+			return entries[a.entry].owner < entries[b.entry].owner;
+		}
+		return a.entry < b.entry;
+	});
+
+	// Pack the bounds in cell order so the colliders in a cell can be tested in one batch
+	for (const auto &cell : cells)
+	{
+		cell_bounds.add(entries[cell.entry].collider);
+	}
+
+	// Find where each occupied cell starts
+	cell_starts.clear();
+	for (size_t i = 0; i < cells.size(); i++)
+	{
+		if (i == 0 || cells[i].cell != cells[i - 1].cell)
+		{
+			cell_starts.push_back(i);
+		}
+	}
+	const size_t cell_count = cell_starts.size();
+	cell_starts.push_back(cells.size());
+
+	// Every run of cells only reads the grid and writes to its own batch, so the runs can be tested in any order on any thread
+	size_t batch_count = 1;
+	if (job_system && job_system->get_thread_count() > 1 && cells.size() >= 2 * job_grain)
+	{
+		batch_count = std::min(cell_count, static_cast<size_t>(job_system->get_thread_count()) * 4);
+	}
+
+	if (batches.size() < batch_count)
+	{
+		batches.resize(batch_count);
+	}
+
+	if (batch_count == 1)
+	{
+		test_cells(0, cell_count, batches[0]);
+	}
+	else
+	{
+		job_system->parallel_for(0, batch_count, 1, [&](size_t begin, size_t end)
+		{
+			for (size_t batch = begin; batch < end; batch++)
+			{
+				test_cells(batch * cell_count / batch_count, (batch + 1) * cell_count / batch_count, batches[batch]);
+			}
+		});
+	}
+
+	// Batches cover the cells in order, so joining them gives the same pairs as testing every cell on one thread
+	for (size_t batch = 0; batch < batch_count; batch++)
+	{
+		pairs.insert(pairs.end(), batches[batch].pairs.begin(), batches[batch].pairs.end());
+		counters.tested += batches[batch].counters.tested;
+		counters.culled += batches[batch].counters.culled;
+	}
+}
+
+void SpatialHash::test_cells(size_t first_cell, size_t last_cell, CellBatch &batch) const
+{
+	batch.pairs.clear();
+	batch.counters = {};
+
+	std::vector<LayerGroup> &layer_groups = batch.layer_groups;
+	std::vector<uint32_t> &cell_hits = batch.cell_hits;
+	CollisionCounters &counters = batch.counters;
+
+	for (size_t cell = first_cell; cell < last_cell; cell++)
+	{
+		size_t start = cell_starts[cell];
+		size_t end = cell_starts[cell + 1];
+
+		// Split the cell into its layers
+		layer_groups.clear();
+		for (size_t i = start; i < end; i++)
+		{
+			CollisionLayer layer = entries[cells[i].entry].layer;
+			if (layer_groups.empty() || layer_groups.back().layer != layer)
+			{
+				layer_groups.push_back({ layer, i, i });
+			}
+			layer_groups.back().end = i + 1;
+		}
+
+		for (size_t group = 0; group < layer_groups.size(); group++)
+		{
+			const LayerGroup &layer_group = layer_groups[group];
+
+			// Colliders belonging to the same object never collide with each other, so within its own layer each
+			// collider is only paired with the colliders after the end of its owner's group
+			size_t owner_end = layer_group.begin;
+
+			for (size_t i = layer_group.begin; i < layer_group.end; i++)
+			{
+				const SpatialHashEntry &entry_1 = entries[cells[i].entry];
+
+				if (i == owner_end)
+				{
+					while (owner_end < layer_group.end && entries[cells[owner_end].entry].owner == entry_1.owner)
+					{
+						owner_end++;
+					}
+				}
+
+				counters.culled += owner_end - i - 1;
+
+				// Test whole runs of colliders at once, skipping layers that don't collide with this one without looking at them
+				cell_hits.clear();
+
+				if (layer_matrix.collides(entry_1.layer, entry_1.layer))
+				{
+					counters.tested += layer_group.end - owner_end;
+					check_collision_rect_batch(entry_1.collider, cell_bounds, owner_end, layer_group.end, cell_hits);
+				}
+				else
+				{
+					counters.culled += layer_group.end - owner_end;
+				}
+
+				for (size_t other = group + 1; other < layer_groups.size(); other++)
+				{
+					const LayerGroup &other_group = layer_groups[other];
+
+					if (layer_matrix.collides(entry_1.layer, other_group.layer))
+					{
+						counters.tested += other_group.end - other_group.begin;
+						check_collision_rect_batch(entry_1.collider, cell_bounds, other_group.begin, other_group.end, cell_hits);
+					}
+					else
+					{
+						counters.culled += other_group.end - other_group.begin;
+					}
+				}
+
+				for (auto j : cell_hits)
+				{
+					const SpatialHashEntry &entry_2 = entries[cells[j].entry];
+
+					// An object can have colliders on several layers, and those still never collide with each other
+					if (entry_2.owner == entry_1.owner)
+					{
+						continue;
+					}
+
+					// Two colliders can share several cells, so only emit the pair from the cell holding the corner where their overlap starts
+					float overlap_x = std::max(entry_1.collider->position.x, entry_2.collider->position.x);
+					float overlap_y = std::max(entry_1.collider->position.y, entry_2.collider->position.y);
+
+					if (cell_key(to_cell(overlap_x), to_cell(overlap_y)) != cells[i].cell)
+					{
+						continue;
+					}
+
+					batch.pairs.push_back({ cells[i].entry, cells[j].entry });
+				}
+			}
+		}
+	}
+}
+
+const std::vector<SpatialHashEntry> &SpatialHash::get_entries() const
+{
+	return entries;
+}
+
+const CollisionCounters &SpatialHash::get_counters() const
+{
+	return counters;
+}
+
+int32_t SpatialHash::to_cell(float value) const
+{
+	return static_cast<int32_t>(std::floor(value * inverse_cell_size));
+}
+
+uint64_t SpatialHash::cell_key(int32_t x, int32_t y) const
+{
+	return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(y));
+}
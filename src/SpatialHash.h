@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include "Collider.h"
+#include "CollisionLayers.h"
+#include "JobSystem.h"
+
+// A collider entered into the spatial hash, tagged with the object that owns it
+struct SpatialHashEntry
+{
+	const Rectangle *collider;
+	uint32_t owner;
+	CollisionLayer layer;
+};
+
+// Uniform grid broadphase. Colliders are bucketed into every cell their bounds overlap,
+// and only colliders sharing a cell are tested against each other.
+class SpatialHash
+{
+public:
+	SpatialHash(float cell_size);
+
+	void clear();
+	void insert(const Rectangle *collider, uint32_t owner, CollisionLayer layer = COLLISION_LAYER_DEFAULT);
+
+	// Layers that don't collide are never tested. Every layer collides with every other by default.
+	void set_layer_matrix(const CollisionLayerMatrix &matrix);
+
+	// Fills pairs with indices into get_entries() of colliders with different owners on colliding layers that overlap. Each pair is emitted once.
+	// With a job system, large grids are split into runs of cells tested in parallel. Pairs come out in the same order either way.
+	void find_pairs(std::vector<std::pair<uint32_t, uint32_t>> &pairs, JobSystem *job_system = nullptr);
+
+	const std::vector<SpatialHashEntry> &get_entries() const;
+
+	// Candidate pairs tested and culled by the last call to find_pairs, counted once per shared cell
+	const CollisionCounters &get_counters() const;
+
+private:
+	struct CellEntry
+	{
+		uint64_t cell;
+		uint32_t entry;
+	};
+
+	// Run of entries in a cell that share a layer
+	struct LayerGroup
+	{
+		CollisionLayer layer;
+		size_t begin;
+		size_t end;
+	};
+
+	// Scratch space and results for one run of cells, so runs can be tested on different threads
+	struct CellBatch
+	{
+		std::vector<LayerGroup> layer_groups;
+		std::vector<uint32_t> cell_hits;
+		std::vector<std::pair<uint32_t, uint32_t>> pairs;
+		CollisionCounters counters;
+	};
+
+	// Tests every collider against the others in occupied cells [first_cell, last_cell)
+	void test_cells(size_t first_cell, size_t last_cell, CellBatch &batch) const;
+
+	int32_t to_cell(float value) const;
+	uint64_t cell_key(int32_t x, int32_t y) const;
+
+	float cell_size;
+	float inverse_cell_size;
+
+	std::vector<SpatialHashEntry> entries;
+	std::vector<CellEntry> cells;
+	RectangleBatch cell_bounds;
+
+	// Index into cells of where each occupied cell starts, followed by the end of the last one
+	std::vector<size_t> cell_starts;
+	std::vector<CellBatch> batches;
+
+	// Fewest cell entries worth splitting over the job system
+	const size_t job_grain = 512;
+
+	CollisionLayerMatrix layer_matrix;
+	CollisionCounters counters;
+};
@@ -0,0 +1,281 @@
+#include "Systems.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// Text is drawn closer to the camera than the arena, so it's spread over a smaller part of the view
+const float glyph_view_size = 1.5f * tan(glm::radians(45.0f / 2.0f));
+
+// Glyphs the text batch has room for to begin with. A game has about 90, counting every screen and the spares each Text keeps.
+const uint32_t initial_text_batch_capacity = 128;
+
+GlyphQuad layout_glyph(const Transform &transform, glm::vec4 atlas_rect)
+{
+	// The textured square sits half a unit in front of the glyph's origin
+	const glm::vec2 centre = transform.location * glyph_view_size;
+	const float z = transform.depth + 0.5f * transform.scale.z;
+
+	// Corners of the square, and which corner of the glyph's rect in the font texture each one shows
+	const glm::vec2 corners[4] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+	const glm::vec2 tex_coords[4] = { { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f } };
+
+	GlyphQuad quad;
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		quad.vertices[i].point = glm::vec3(centre.x + corners[i].x * transform.scale.x, centre.y + corners[i].y * transform.scale.y, z);
+		quad.vertices[i].tex_coord = glm::vec2(atlas_rect.x + tex_coords[i].x * atlas_rect.z, atlas_rect.y + tex_coords[i].y * atlas_rect.w);
+	}
+
+	return quad;
+}
+
+void update_lifetimes(EntityRegistry &entities, float time, bool paused)
+{
+	for (auto &lifetime : entities.lifetimes.get_components())
+	{
+		if (!paused || lifetime.runs_while_paused)
+		{
+			lifetime.elapsed += time;
+		}
+	}
+}
+
+void place_colliders(EntityRegistry &entities, ColliderRegistry &collider_registry)
+{
+	const auto &handles = entities.colliders.get_components();
+	const auto &owners = entities.colliders.get_entities();
+
+	for (size_t i = 0; i < handles.size(); i++)
+	{
+		if (handles[i].follow)
+		{
+			const Transform &transform = entities.transforms.get(owners[i]);
+			collider_registry.get(handles[i].collider).set_placement(transform.location - handles[i].size / 2.f, handles[i].size);
+		}
+	}
+}
+
+void place_sounds(EntityRegistry &entities, SoundManager &sound_manager, double tick_time)
+{
+	const auto &handles = entities.sounds.get_components();
+	const auto &owners = entities.sounds.get_entities();
+
+	for (size_t i = 0; i < handles.size(); i++)
+	{
+		if (!handles[i].positional)
+		{
+			continue;
+		}
+
+		const Transform &transform = entities.transforms.get(owners[i]);
+		glm::vec2 velocity = tick_time > 0.0 ? (transform.location - transform.previous_location) / float(tick_time) : glm::vec2(0.0);
+
+		for (uint32_t j = 0; j < handles[i].sound_count; j++)
+		{
+			sound_manager.update_sound_position(handles[i].sounds[j], transform.location.x, transform.location.y, 0.0);
+			sound_manager.update_sound_velocity(handles[i].sounds[j], velocity.x, velocity.y, 0.0);
+		}
+	}
+}
+
+void pause_sounds(EntityRegistry &entities, SoundManager &sound_manager)
+{
+	for (auto &handle : entities.sounds.get_components())
+	{
+		for (uint32_t i = 0; i < handle.sound_count; i++)
+		{
+			handle.resume[i] = sound_manager.is_sound_playing(handle.sounds[i]);
+			if (handle.resume[i])
+			{
+				sound_manager.pause_sound(handle.sounds[i]);
+			}
+		}
+	}
+}
+
+void resume_sounds(EntityRegistry &entities, SoundManager &sound_manager)
+{
+	for (auto &handle : entities.sounds.get_components())
+	{
+		for (uint32_t i = 0; i < handle.sound_count; i++)
+		{
+			if (handle.resume[i])
+			{
+				sound_manager.play_sound(handle.sounds[i]);
+			}
+		}
+	}
+}
+
+RenderSystem::RenderSystem(Renderer *renderer, JobSystem *job_system)
+{
+	this->renderer = renderer;
+	this->job_system = job_system;
+
+	TextBatchParameters text_batch_parameters = {};
+	text_batch_parameters.max_glyphs = initial_text_batch_capacity;
+	text_batch = create_text_batch(*renderer, text_batch_parameters);
+	text_batch_capacity = initial_text_batch_capacity;
+
+	glyph_vertices.reserve(4 * initial_text_batch_capacity);
+}
+
+RenderSystem::~RenderSystem()
+{
+	if (renderer->device.device != VK_NULL_HANDLE)
+	{
+		free_text_batch(*renderer, text_batch);
+	}
+}
+
+void RenderSystem::submit(const EntityRegistry &entities, glm::mat4 view, glm::mat4 proj, float width, float height, float interpolation)
+{
+	// Move lights first so meshes pick up where they are this frame
+	const auto &lights = entities.lights.get_components();
+	const auto &light_owners = entities.lights.get_entities();
+
+	for (size_t i = 0; i < lights.size(); i++)
+	{
+		if (!lights[i].enabled)
+		{
+			continue;
+		}
+
+		const Transform &transform = entities.transforms.get(light_owners[i]);
+		glm::vec2 draw_location = glm::mix(transform.previous_location, transform.location, interpolation);
+
+		LightUpdateParameters light_update_parameters = {};
+		light_update_parameters.light = lights[i].light;
+		light_update_parameters.color = lights[i].color;
+		light_update_parameters.intensity = lights[i].intensity;
+		light_update_parameters.max_distance = lights[i].max_distance;
+		light_update_parameters.location = glm::vec3(draw_location + lights[i].offset, transform.depth);
+		update_light(*renderer, light_update_parameters);
+	}
+
+	const auto &renders = entities.renders.get_components();
+	const auto &render_owners = entities.renders.get_entities();
+
+	// translate * scale built directly, since nothing is rotated
+	auto model_matrix = [&](size_t i)
+	{
+		// Draw between the last two ticks
+		const Transform &transform = entities.transforms.get(render_owners[i]);
+		glm::vec2 draw_location = glm::mix(transform.previous_location, transform.location, interpolation);
+
+		if (renders[i].kind == RENDER_KIND_MESH)
+		{
+			draw_location = glm::vec2(draw_location.x * width, draw_location.y * height);
+		}
+
+		glm::mat4 model(1);
+		model[0][0] = transform.scale.x;
+		model[1][1] = transform.scale.y;
+		model[2][2] = transform.scale.z;
+		model[3] = glm::vec4(draw_location.x, draw_location.y, transform.depth, 1.f);
+
+		return model;
+	};
+
+	// With more than one thread, work out every model matrix up front spread over the job system. Otherwise they're worked out as they're submitted.
+	const bool precompute = job_system->get_thread_count() > 1 && renders.size() >= 2 * job_grain;
+	if (precompute)
+	{
+		models.resize(renders.size());
+
+		job_system->parallel_for(0, renders.size(), job_grain, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				if (renders[i].visible)
+				{
+					models[i] = model_matrix(i);
+				}
+			}
+		});
+	}
+
+	// The renderer isn't thread safe, so hand everything over from this thread
+	glyph_vertices.clear();
+
+	for (size_t i = 0; i < renders.size(); i++)
+	{
+		const RenderHandle &render = renders[i];
+
+		if (!render.visible)
+		{
+			continue;
+		}
+
+		// Glyphs were laid out when they last changed, so they're only copied into the batch that's drawn once everything else has been submitted
+		if (render.kind == RENDER_KIND_GLYPH)
+		{
+			const GlyphQuad &quad = entities.glyph_quads.get(render_owners[i]);
+			glyph_vertices.insert(glyph_vertices.end(), std::begin(quad.vertices), std::end(quad.vertices));
+			continue;
+		}
+
+		const glm::mat4 model = precompute ? models[i] : model_matrix(i);
+
+		UniformBufferUpdateParameters update_parameters = {};
+		update_parameters.buffer = render.uniform_buffer;
+
+		MeshUniform mesh_data;
+		OverlayUniform overlay_data;
+
+		if (render.kind == RENDER_KIND_MESH)
+		{
+			mesh_data.model = model;
+			mesh_data.view = view;
+			mesh_data.proj = proj;
+			mesh_data.light_index = entities.lights.has(render_owners[i]) ? int(entities.lights.get(render_owners[i]).light.index) : -1;
+			update_parameters.data = &mesh_data;
+		}
+		else
+		{
+			overlay_data.model = model;
+			overlay_data.view = view;
+			overlay_data.proj = proj;
+			overlay_data.time = entities.lifetimes.has(render_owners[i]) ? entities.lifetimes.get(render_owners[i]).elapsed : 0.f;
+			update_parameters.data = &overlay_data;
+		}
+
+		update_uniform_buffer(*renderer, update_parameters);
+
+		InstanceSubmitParameters submit_parameters = {};
+		submit_parameters.instance = render.instance;
+
+		submit_instance(*renderer, submit_parameters);
+	}
+
+	const uint32_t glyph_count = static_cast<uint32_t>(glyph_vertices.size() / 4);
+
+	if (glyph_count > text_batch_capacity)
+	{
+		free_text_batch(*renderer, text_batch);
+
+		while (text_batch_capacity < glyph_count)
+		{
+			text_batch_capacity *= 2;
+		}
+
+		TextBatchParameters text_batch_parameters = {};
+		text_batch_parameters.max_glyphs = text_batch_capacity;
+		text_batch = create_text_batch(*renderer, text_batch_parameters);
+	}
+
+	if (glyph_count == 0)
+	{
+		return;
+	}
+
+	// Every glyph drawn in one go
+	TextBatchUpdateParameters text_update_parameters = {};
+	text_update_parameters.batch = text_batch;
+	text_update_parameters.vertices = glyph_vertices.data();
+	text_update_parameters.glyph_count = glyph_count;
+	text_update_parameters.view = view;
+	text_update_parameters.proj = proj;
+	update_text_batch(*renderer, text_update_parameters);
+
+	submit_text_batch(*renderer, text_batch);
+}
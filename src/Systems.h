@@ -0,0 +1,72 @@
+#pragma once
+
+#include <glm/mat4x4.hpp>
+#include <vector>
+#include "Renderer/Renderer.h"
+#include "EntityRegistry.h"
+#include "JobSystem.h"
+#include "SoundManager.h"
+
+// Uniform for RENDER_KIND_MESH entities
+struct MeshUniform
+{
+	glm::mat4 model;
+	glm::mat4 view;
+	glm::mat4 proj;
+	int light_index;
+};
+
+// Uniform for RENDER_KIND_OVERLAY entities. Overlays that don't animate just ignore time.
+struct OverlayUniform
+{
+	glm::mat4 model;
+	glm::mat4 view;
+	glm::mat4 proj;
+	float time;
+};
+
+// Advances every lifetime by time. While paused only the ones that run while paused move on.
+void update_lifetimes(EntityRegistry &entities, float time, bool paused);
+
+// Places every following collider centred on its entity
+void place_colliders(EntityRegistry &entities, ColliderRegistry &collider_registry);
+
+// Moves every positional sound to its entity, moving at the speed the entity did over the last tick of tick_time seconds
+void place_sounds(EntityRegistry &entities, SoundManager &sound_manager, double tick_time);
+
+// Pauses every playing entity sound and remembers which ones to start again in resume_sounds
+void pause_sounds(EntityRegistry &entities, SoundManager &sound_manager);
+void resume_sounds(EntityRegistry &entities, SoundManager &sound_manager);
+
+// Lays out the corners of a glyph drawn at transform, showing atlas_rect (x, y, width and height from 0 to 1) of the font texture
+GlyphQuad layout_glyph(const Transform &transform, glm::vec4 atlas_rect);
+
+// Draws every visible entity and moves every enabled light to its entity. Glyphs are packed into one text batch and drawn together.
+class RenderSystem
+{
+public:
+	// Large numbers of entities have their model matrices worked out over the job system
+	RenderSystem(Renderer *renderer, JobSystem *job_system);
+	~RenderSystem();
+
+	// width and height are the size of the arena in view space. interpolation is how far between the last two ticks to draw, from 0 to 1.
+	void submit(const EntityRegistry &entities, glm::mat4 view, glm::mat4 proj, float width, float height, float interpolation);
+
+	RenderSystem(const RenderSystem&) = delete;
+
+private:
+	Renderer *renderer;
+	JobSystem *job_system;
+
+	// Each render component's model matrix, in component order, when they're worked out over the job system
+	std::vector<glm::mat4> models;
+
+	// Vertices of the visible glyphs gathered this frame, and the batch they're drawn with. The batch is replaced with a bigger one if they don't fit.
+	std::vector<TextVertex> glyph_vertices;
+	TextBatchID text_batch;
+	uint32_t text_batch_capacity;
+
+	// Fewest entities worth splitting into a separate job. A game draws far fewer than two jobs' worth, so in play every
+	// model matrix is worked out as it's submitted, on the calling thread.
+	const size_t job_grain = 1024;
+};
@@ -2,16 +2,23 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 
-Text::Text(Renderer *renderer, Font *font, glm::vec2 location, float scale_factor, std::string string)
+Text::Text(EntityRegistry *entities, const Font *font, glm::vec2 location, float scale_factor, std::string string)
 {
-	this->renderer = renderer;
-	scale = glm::scale(glm::mat4(1), glm::vec3(0.1f, 0.1f, 1.0f));
+	this->entities = entities;
 	this->location = glm::vec3(location, 0.5);
 	this->scale_factor = scale_factor;
 	this->font = font;
+	visible = true;
+	showing_number = false;
+	number = 0;
+	location_changed = false;
+
+	// Room for any number, so update_number never has to grow the string
+	this->string.reserve(max_number_length);
 
 	characters = {};
-	inactive_characters = std::stack<Character *>({ new Character(renderer, location, scale_factor, font, ' ', ' ') });
+	inactive_characters = std::stack<Character *>({ new Character(entities, location, scale_factor, font, ' ', ' ') });
+	inactive_characters.top()->set_visible(false);
 
 	// Set initial value of the string
 	update_string(string);
@@ -31,100 +38,127 @@ Text::~Text()
 	}
 }
 
-void Text::update(double time)
+void Text::update_string(const std::string &string)
 {
-
+	// If you're changing the string to anything new
+	if (this->string != string || location_changed)
+	{
+		showing_number = false;
+		set_characters(string.data(), string.size());
+	}
 }
 
-std::vector<Rectangle *> Text::get_collider()
+void Text::update_number(int number)
 {
-	return {};
-}
+	if (showing_number && this->number == number && !location_changed)
+	{
+		return;
+	}
 
-void Text::submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height) const
-{
-	for (auto character : characters)
+	// Write the digits backwards from the end of the buffer
+	char buffer[max_number_length];
+	size_t start = max_number_length;
+
+	// Work with the magnitude as unsigned so the most negative int doesn't overflow
+	uint32_t magnitude = number < 0 ? 0u - static_cast<uint32_t>(number) : static_cast<uint32_t>(number);
+	do
 	{
-		character->submit_for_rendering(view, proj, width, height);
+		buffer[--start] = char('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0);
+
+	if (number < 0)
+	{
+		buffer[--start] = '-';
 	}
-}
 
-void Text::handle_external_collisions(const Rectangle *collider, const GameObject *other)
-{
+	showing_number = true;
+	this->number = number;
 
+	set_characters(buffer + start, max_number_length - start);
 }
 
-void Text::pause()
+void Text::set_characters(const char *new_string, size_t length)
 {
-	
-}
+	// Characters before the first one that changed are already laid out, unless the whole text moved
+	size_t first_changed = 0;
+	if (!location_changed)
+	{
+		while (first_changed < length && first_changed < string.size() && string[first_changed] == new_string[first_changed])
+		{
+			first_changed++;
+		}
+	}
+	location_changed = false;
 
-void Text::unpause()
-{
-	
-}
+	// Update the string value, reusing its storage
+	string.assign(new_string, length);
 
-void Text::update_string(std::string string)
-{
-	// If you're changing the string to anything new
-	if (this->string != string)
+	// If the string is smaller than the previous one, move character objects into inactive_characters
+	while (length < characters.size())
 	{
-		// Update the string value
-		this->string = string;
+		characters.back()->set_visible(false);
+		inactive_characters.push(characters.back());
+		characters.pop_back();
+	}
 
-		// If the string is smaller than the previous one
-		if (string.size() < characters.size())
+	// For each character that changed or follows one that did, since its location depends on the ones before it
+	for (size_t i = first_changed; i < length; i++)
+	{
+		// If we have used all the characters in the characters vector
+		if (i >= characters.size())
 		{
-			// Move character objects into inactive_characters
-			for (size_t i = string.size(); i < characters.size(); i++)
+			// Move a character in from inactive_characters
+			characters.push_back(inactive_characters.top());
+			characters.back()->set_visible(visible);
+			inactive_characters.pop();
+
+			if (inactive_characters.size() == 0)
 			{
-				inactive_characters.push(characters.back());
-				characters.erase(characters.end());
+				inactive_characters.push(new Character(entities, glm::vec2(location.x, location.y), scale_factor, font, ' ', ' '));
+				inactive_characters.top()->set_visible(false);
 			}
 		}
 
-		// For each character in the string
-		for (int i = 0; i < int(string.size()); i++)
+		// If this is the first character in the string
+		if (i == 0)
 		{
-			// If we have used all the characters in the characters vector
-			if (i > int(characters.size()) - 1)
-			{
-				// Move a character in from inactive_characters
-				characters.push_back(inactive_characters.top());
-				inactive_characters.pop();
-
-				if (inactive_characters.size() == 0)
-				{
-					inactive_characters.push(new Character(this->renderer, glm::vec2(location.x, location.y), scale_factor, font, ' ', ' '));
-				}
-			}
+			// Set the first character to the string's location and update the character
+			characters[i]->update_location(glm::vec2(location.x, location.y));
+			characters[i]->update_character(string[i], 10);
+		}
+		else
+		{
+			// Update character
+			characters[i]->update_character(string[i], string[i-1]);
 
-			// If this is the first character in the string
-			if (i == 0)
-			{ 
-				// Set the first character to the string's location and update the character
-				characters[i]->update_location(glm::vec2(location.x, location.y));
-				characters[i]->update_character(string[i], 10);
-			}
-			else
-			{
-				// Update character
-				characters[i]->update_character(string[i], string[i-1]);
-				
-				// Represents data about the previous character
-				CharacterDetails previous_character = font->chars[characters[i - 1]->get_character()];
+			// Represents data about the previous character
+			const CharacterDetails &previous_character = font->chars[characters[i - 1]->get_character()];
 
-				// Represents data about the current character
-				CharacterDetails current_character = font->chars[characters[i]->get_character()];
+			// Represents data about the current character
+			const CharacterDetails &current_character = font->chars[characters[i]->get_character()];
 
-				// Find location of current character based on the advance value of the previous character along with the amount the character has been resized
-				characters[i]->update_location(characters[i - 1]->get_location() + glm::vec2(0.7 * previous_character.advance / float(font->total_width) + scale_factor * (current_character.width / float(1.25 * font->total_width)), 0));
-			}
+			// Find location of current character based on the advance value of the previous character along with the amount the character has been resized
+			characters[i]->update_location(characters[i - 1]->get_location() + glm::vec2(0.7 * previous_character.advance / float(font->total_width) + scale_factor * (current_character.width / float(1.25 * font->total_width)), 0));
 		}
 	}
 }
 
 void Text::update_position(glm::vec3 new_location)
 {
-	location = new_location;
-}
\ No newline at end of file
+	if (new_location != location)
+	{
+		location = new_location;
+		location_changed = true;
+	}
+}
+
+void Text::set_visible(bool visible)
+{
+	this->visible = visible;
+
+	for (auto character : characters)
+	{
+		character->set_visible(visible);
+	}
+}
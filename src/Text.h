@@ -5,29 +5,47 @@
 #include <string>
 #include <stack>
 
-class Text : public GameObject
+// Longest string update_number can produce, "-2147483648"
+const size_t max_number_length = 11;
+
+class Text
 {
 public:
-	Text(Renderer *renderer, Font *font, glm::vec2 location, float scale_factor, std::string string);
-	virtual ~Text();
-	virtual void update(double time);
-	virtual std::vector<Rectangle *> get_collider();
-	virtual void submit_for_rendering(glm::mat4 view, glm::mat4 proj, float width, float height) const;
-	virtual void handle_external_collisions(const Rectangle *collider, const GameObject *other);
-	virtual void pause();
-	virtual void unpause();
-
-	void update_string(std::string string);
+	Text(EntityRegistry *entities, const Font *font, glm::vec2 location, float scale_factor, std::string string);
+	~Text();
+
+	void update_string(const std::string &string);
+
+	// Shows number in decimal without allocating. Does nothing if it's the number already shown.
+	void update_number(int number);
+
+	// Takes effect the next time the text changes
 	void update_position(glm::vec3 new_location);
+
+	// Hidden text keeps its glyphs but the render system skips them
+	void set_visible(bool visible);
+
+	Text(const Text&) = delete;
+
 private:
-	Renderer *renderer;
+	// Lays out new_string, only touching the characters from the first one that differs from the current string
+	void set_characters(const char *new_string, size_t length);
+
+	EntityRegistry *entities;
 
-	glm::mat4 scale;
 	glm::vec3 location;
 
-	Font *font;
+	const Font *font;
 	std::string string;
 	std::vector<Character *> characters;
 	std::stack<Character *> inactive_characters;
 	float scale_factor;
-};
\ No newline at end of file
+	bool visible;
+
+	// Whether the text was last set by update_number, and to what
+	bool showing_number;
+	int number;
+
+	// Set when the location moves, so the next change lays out every character again
+	bool location_changed;
+};
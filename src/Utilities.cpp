@@ -2,12 +2,9 @@
 
 #include <stdio.h>
 
-int random_int(int low, int high)
+uint32_t time_seed()
 {
-	static std::mt19937 generator(static_cast<unsigned int>(std::chrono::steady_clock::now().time_since_epoch().count()));
-	std::uniform_int_distribution<int> distribution(low, high);
-
-	return distribution(generator);
+	return static_cast<uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
 }
 
 int num_digits(int value)
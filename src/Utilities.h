@@ -1,13 +1,15 @@
 #pragma once
 
-#include <random>
 #include <chrono>
+#include <stdint.h>
+#include <string>
 
 #include "AL/al.h"
 
 constexpr auto PI = 3.141592f;
 
-int random_int(int low, int high);
+// Seed that differs from run to run
+uint32_t time_seed();
 
 int num_digits(int value);
 